@@ -0,0 +1,110 @@
+/**
+ * @file book_bench.cpp
+ * @brief Diff-apply throughput of L2Book against the previous std::map book.
+ *
+ * A 1000-level-per-side book is loaded, then a deterministic stream of
+ * diff-depth style changes is applied: most hit the 20 levels around the
+ * touch, a few land deep in the book, about a third are deletions. The same
+ * changes feed both books and their top of book is cross-checked.
+ *
+ * Qt-free. Build with -DBUILD_BENCHMARKS=ON, then run ./book_bench [changes].
+ */
+
+#include "L2Book.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <map>
+#include <random>
+
+namespace {
+
+struct Change {
+    BookSide side;
+    BookLevel level;
+};
+
+constexpr int64_t MID_TICKS = 6400000;     // 64000.00 at a 0.01 tick
+constexpr int BOOK_LEVELS = 1000;
+
+Price ticks(int64_t t) {
+    return Price::fromRaw(t * 1000000);    // 0.01 per tick
+}
+
+std::vector<Change> makeChanges(size_t count) {
+    std::mt19937_64 rng(7);
+    std::uniform_int_distribution<int> nearTouch(1, 20), deep(21, BOOK_LEVELS);
+    std::uniform_int_distribution<int> qty(1, 500000);
+    std::bernoulli_distribution bidSide(0.5), isDeep(0.1), isDelete(0.33);
+
+    std::vector<Change> changes;
+    changes.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        const bool bid = bidSide(rng);
+        const int offset = isDeep(rng) ? deep(rng) : nearTouch(rng);
+        Change c;
+        c.side = bid ? BookSide::Bid : BookSide::Ask;
+        c.level.price = ticks(bid ? MID_TICKS - offset : MID_TICKS + offset);
+        c.level.qty = isDelete(rng) ? Qty() : Qty::fromRaw(qty(rng) * 1000);
+        changes.push_back(c);
+    }
+    return changes;
+}
+
+void initialLevels(std::vector<BookLevel>& bids, std::vector<BookLevel>& asks) {
+    for (int i = 1; i <= BOOK_LEVELS; ++i) {
+        bids.push_back({ticks(MID_TICKS - i), Qty::fromRaw(100000 * i)});
+        asks.push_back({ticks(MID_TICKS + i), Qty::fromRaw(100000 * i)});
+    }
+}
+
+double seconds(const std::function<void()>& work) {
+    const auto start = std::chrono::steady_clock::now();
+    work();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t count = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 2000000;
+    const std::vector<Change> changes = makeChanges(count);
+
+    std::vector<BookLevel> bids, asks;
+    initialLevels(bids, asks);
+
+    L2Book book;
+    book.applySnapshot(bids, asks);
+    const double flatSeconds = seconds([&]() {
+        for (const Change& c : changes) book.setLevel(c.side, c.level.price, c.level.qty);
+    });
+
+    std::map<Price, Qty, std::greater<Price>> mapBids;
+    std::map<Price, Qty> mapAsks;
+    for (const BookLevel& lvl : bids) mapBids[lvl.price] = lvl.qty;
+    for (const BookLevel& lvl : asks) mapAsks[lvl.price] = lvl.qty;
+    const double mapSeconds = seconds([&]() {
+        for (const Change& c : changes) {
+            if (c.side == BookSide::Bid) {
+                if (c.level.qty.isPositive()) mapBids[c.level.price] = c.level.qty;
+                else mapBids.erase(c.level.price);
+            } else {
+                if (c.level.qty.isPositive()) mapAsks[c.level.price] = c.level.qty;
+                else mapAsks.erase(c.level.price);
+            }
+        }
+    });
+
+    const bool consistent = book.depth(BookSide::Bid) == mapBids.size()
+        && book.depth(BookSide::Ask) == mapAsks.size()
+        && (mapBids.empty() || book.bestBid()->price == mapBids.begin()->first)
+        && (mapAsks.empty() || book.bestAsk()->price == mapAsks.begin()->first);
+
+    std::printf("%zu changes, final depth %zu/%zu levels\n", count,
+                book.depth(BookSide::Bid), book.depth(BookSide::Ask));
+    std::printf("  L2Book    %8.1f M changes/s\n", count / flatSeconds / 1e6);
+    std::printf("  std::map  %8.1f M changes/s\n", count / mapSeconds / 1e6);
+    std::printf("  books %s\n", consistent ? "match" : "DIFFER");
+    return consistent ? 0 : 1;
+}
@@ -0,0 +1,76 @@
+/**
+ * @file checksum_check.cpp
+ * @brief Known-answer check of BookChecksum against hard-coded CRCs.
+ *
+ * The mock adapter signs its diffs with BookChecksum itself, so a change to
+ * the checksummed text would go unnoticed at run time. This pins the format
+ * instead: the CRC-32 check value, the two worked examples of the OKX depth
+ * checksum documentation (one side shorter than the other), and levels sent
+ * with trailing zeros. Levels are parsed from payload text, as the decoder
+ * does.
+ *
+ * Qt-free. Build with -DBUILD_BENCHMARKS=ON, then run ./checksum_check;
+ * exits non-zero on a mismatch.
+ */
+
+#include "BookChecksum.h"
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+/// Levels as sent by the venue and the expected CRC.
+struct KnownAnswer {
+    const char* text;           // Checksummed text, for the report
+    const char* bids[2][2];
+    size_t bidCount;
+    const char* asks[3][2];
+    size_t askCount;
+    uint32_t crc;
+};
+
+const KnownAnswer KNOWN_ANSWERS[] = {
+    {"3366.1:7:3366.8:9:3366:6:3368:8",
+     {{"3366.1", "7"}, {"3366", "6"}}, 2, {{"3366.8", "9"}, {"3368", "8"}}, 2, 2413953002u},
+    {"3366.1:7:3366.8:9:3368:8:3372:8",
+     {{"3366.1", "7"}}, 1, {{"3366.8", "9"}, {"3368", "8"}, {"3372", "8"}}, 3, 831078360u},
+    {"64012.5:0.003:64012.6:1.25:64012:12",
+     {{"64012.50000000", "0.00300000"}, {"64012.00000000", "12.00000000"}}, 2,
+     {{"64012.60000000", "1.25000000"}}, 1, 786180631u},
+};
+
+BookLevel parseLevel(const char* price, const char* qty) {
+    BookLevel level;
+    Price::parse(price, level.price);
+    Qty::parse(qty, level.qty);
+    return level;
+}
+
+} // namespace
+
+int main() {
+    int failures = 0;
+
+    const char* check = "123456789";
+    const uint32_t crc = BookChecksum::crc32(check, std::strlen(check));
+    if (crc != 0xCBF43926u) {
+        std::printf("FAIL crc32(\"%s\") = %08x, expected cbf43926\n", check, crc);
+        failures++;
+    }
+
+    for (const KnownAnswer& known : KNOWN_ANSWERS) {
+        BookLevel bids[2];
+        BookLevel asks[3];
+        for (size_t i = 0; i < known.bidCount; ++i) bids[i] = parseLevel(known.bids[i][0], known.bids[i][1]);
+        for (size_t i = 0; i < known.askCount; ++i) asks[i] = parseLevel(known.asks[i][0], known.asks[i][1]);
+        const uint32_t got = BookChecksum::compute(bids, known.bidCount, asks, known.askCount);
+        if (got != known.crc) {
+            std::printf("FAIL \"%s\": %u, expected %u\n", known.text, got, known.crc);
+            failures++;
+        }
+    }
+
+    std::printf("%s: %d of %zu known answers failed\n", failures ? "FAIL" : "OK", failures,
+                sizeof(KNOWN_ANSWERS) / sizeof(KNOWN_ANSWERS[0]) + 1);
+    return failures ? 1 : 0;
+}
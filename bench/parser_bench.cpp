@@ -0,0 +1,176 @@
+/**
+ * @file parser_bench.cpp
+ * @brief Throughput of the SAX market parsers against the QJsonDocument path.
+ *
+ * Payloads are synthetic but shaped like the real Binance messages (1000-level
+ * depth snapshot, 100 ms diff-depth events, 500 klines). Each parser runs over
+ * the same bytes and the result is reported in MB/s of input JSON.
+ *
+ * Build with -DBUILD_BENCHMARKS=ON, then run ./parser_bench [iterations].
+ */
+
+#include "SaxParsers.h"
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QString>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+
+namespace {
+
+// ==========================================
+// Payload generation
+// ==========================================
+
+QByteArray levelsJson(double start, double step, int count) {
+    QByteArray out = "[";
+    for (int i = 0; i < count; ++i) {
+        if (i) out += ',';
+        out += "[\"" + QByteArray::number(start + step * i, 'f', 2) + "\",\""
+             + QByteArray::number(0.001 + (i % 37) * 0.137, 'f', 8) + "\"]";
+    }
+    return out + "]";
+}
+
+QByteArray depthSnapshotJson() {
+    return "{\"lastUpdateId\":1027024,\"bids\":" + levelsJson(64000.0, -0.01, 1000)
+         + ",\"asks\":" + levelsJson(64000.01, 0.01, 1000) + "}";
+}
+
+QByteArray depthEventJson() {
+    return "{\"stream\":\"btcusdt@depth@100ms\",\"data\":{\"e\":\"depthUpdate\",\"E\":1700000000000,"
+           "\"s\":\"BTCUSDT\",\"U\":157,\"u\":160,\"b\":" + levelsJson(63990.0, -0.01, 20)
+         + ",\"a\":" + levelsJson(64010.0, 0.01, 20) + "}}";
+}
+
+QByteArray klinesJson() {
+    QByteArray out = "[";
+    for (int i = 0; i < 500; ++i) {
+        if (i) out += ',';
+        const double o = 64000.0 + (i % 50);
+        out += "[" + QByteArray::number(1700000000000LL + i * 60000LL) + ",\""
+             + QByteArray::number(o, 'f', 8) + "\",\"" + QByteArray::number(o + 12.5, 'f', 8) + "\",\""
+             + QByteArray::number(o - 9.25, 'f', 8) + "\",\"" + QByteArray::number(o + 3.0, 'f', 8) + "\",\""
+             + QByteArray::number(12.345 + i, 'f', 8) + "\"," + QByteArray::number(1700000059999LL + i * 60000LL)
+             + ",\"790000.12345678\",1234,\"6.1\",\"390000.1\",\"0\"]";
+    }
+    return out + "]";
+}
+
+// ==========================================
+// Reference: the QJsonDocument decode path
+// ==========================================
+
+void qtLevels(const QJsonArray& array, std::vector<BookLevel>& out) {
+    out.reserve(array.size());
+    for (const QJsonValue& val : array) {
+        QJsonArray entry = val.toArray();
+        if (entry.size() >= 2) {
+            out.push_back({Price::fromDouble(entry[0].toString().toDouble()),
+                           Qty::fromDouble(entry[1].toString().toDouble())});
+        }
+    }
+}
+
+bool qtDepthSnapshot(const QByteArray& payload, DepthSnapshot& out) {
+    QJsonDocument doc = QJsonDocument::fromJson(payload);
+    if (!doc.isObject()) return false;
+    QJsonObject obj = doc.object();
+    out.lastUpdateId = static_cast<int64_t>(obj["lastUpdateId"].toDouble());
+    out.bids.clear();
+    out.asks.clear();
+    qtLevels(obj["bids"].toArray(), out.bids);
+    qtLevels(obj["asks"].toArray(), out.asks);
+    return true;
+}
+
+bool qtDepthEvent(const QByteArray& payload, StreamEvent& out) {
+    QJsonObject data = QJsonDocument::fromJson(payload).object()["data"].toObject();
+    out.symbol.assign(data["s"].toString().toStdString());
+    out.depth.firstUpdateId = static_cast<int64_t>(data["U"].toDouble());
+    out.depth.lastUpdateId = static_cast<int64_t>(data["u"].toDouble());
+    out.depth.bids.clear();
+    out.depth.asks.clear();
+    qtLevels(data["b"].toArray(), out.depth.bids);
+    qtLevels(data["a"].toArray(), out.depth.asks);
+    return !out.depth.bids.empty();
+}
+
+bool qtKlines(const QByteArray& payload, std::vector<Candle>& out) {
+    QJsonDocument doc = QJsonDocument::fromJson(payload);
+    if (!doc.isArray()) return false;
+    out.clear();
+    for (const QJsonValue& val : doc.array()) {
+        QJsonArray k = val.toArray();
+        Candle c;
+        c.openTime = static_cast<int64_t>(k[0].toDouble());
+        c.open = k[1].toString().toDouble();
+        c.high = k[2].toString().toDouble();
+        c.low = k[3].toString().toDouble();
+        c.close = k[4].toString().toDouble();
+        c.volume = k[5].toString().toDouble();
+        out.push_back(c);
+    }
+    return true;
+}
+
+// ==========================================
+// Harness
+// ==========================================
+
+double measureMBps(const QByteArray& payload, int iterations, const std::function<bool()>& parse) {
+    // Warm-up also sizes the reusable output buffers
+    for (int i = 0; i < 10; ++i) {
+        if (!parse()) {
+            std::fprintf(stderr, "parse failed\n");
+            std::exit(1);
+        }
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < iterations; ++i) parse();
+    const double seconds = timer.nsecsElapsed() / 1e9;
+    return payload.size() * double(iterations) / (1024.0 * 1024.0) / seconds;
+}
+
+void report(const char* name, const QByteArray& payload, int iterations,
+            const std::function<bool()>& sax, const std::function<bool()>& qt) {
+    const double saxMBps = measureMBps(payload, iterations, sax);
+    const double qtMBps = measureMBps(payload, iterations, qt);
+    std::printf("%-16s %8lld B  SAX %8.1f MB/s  QJson %8.1f MB/s  x%.2f\n",
+                name, static_cast<long long>(payload.size()), saxMBps, qtMBps, saxMBps / qtMBps);
+}
+
+std::string_view view(const QByteArray& bytes) {
+    return std::string_view(bytes.constData(), static_cast<size_t>(bytes.size()));
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const int iterations = argc > 1 ? std::atoi(argv[1]) : 2000;
+
+    const QByteArray snapshot = depthSnapshotJson();
+    const QByteArray event = depthEventJson();
+    const QByteArray klines = klinesJson();
+
+    DepthSnapshot book;
+    StreamEvent diff;
+    std::vector<Candle> candles;
+
+    report("depth snapshot", snapshot, iterations,
+           [&] { return MarketSaxParser::parseDepthSnapshot(view(snapshot), book); },
+           [&] { return qtDepthSnapshot(snapshot, book); });
+    report("depth event", event, iterations * 50,
+           [&] { return MarketSaxParser::parseStreamEvent(view(event), diff); },
+           [&] { return qtDepthEvent(event, diff); });
+    report("klines", klines, iterations,
+           [&] { return MarketSaxParser::parseKlines(view(klines), candles); },
+           [&] { return qtKlines(klines, candles); });
+    return 0;
+}
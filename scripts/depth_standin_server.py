@@ -0,0 +1,199 @@
+#!/usr/bin/env python3
+"""
+Local stand-in for the Binance depth endpoints, used to exercise the
+order book diff-depth sync without touching the real exchange.
+
+Serves on a single port:
+  GET /api/v3/depth?symbol=XXX&limit=N   -> REST snapshot (lastUpdateId, bids, asks)
+  GET /stream                            -> combined-stream WebSocket: SUBSCRIBE /
+                                            UNSUBSCRIBE control frames are acknowledged
+                                            ({"result":null,"id":N}) and every subscribed
+                                            <pair>@depth@100ms stream receives depthUpdate
+                                            events wrapped as {"stream":...,"data":...}
+
+Other REST endpoints answer 404 and other streams are acknowledged but stay
+silent, so the rest of the screen simply has no data.
+
+Point the application at it with
+  TradingLayoutSkeleton --rest-url http://127.0.0.1:8765 --ws-url ws://127.0.0.1:8765
+
+Use --gap-every N to drop one update id every N events and check that the
+client detects the gap and resyncs from a fresh snapshot.
+Only the Python standard library is required.
+"""
+import argparse
+import asyncio
+import base64
+import hashlib
+import json
+import random
+import struct
+from urllib.parse import urlparse, parse_qs
+
+WS_GUID = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11"
+
+
+class SyntheticBook:
+    """Random-walk book with a monotonically increasing update id."""
+
+    def __init__(self, mid: float, tick: float):
+        self.tick = tick
+        self.update_id = 1000
+        self.bids = {}
+        self.asks = {}
+        for i in range(1, 1001):
+            self.bids[round(mid - i * tick, 2)] = round(random.uniform(0.01, 3.0), 4)
+            self.asks[round(mid + i * tick, 2)] = round(random.uniform(0.01, 3.0), 4)
+
+    def snapshot(self, limit: int) -> dict:
+        bids = sorted(self.bids.items(), reverse=True)[:limit]
+        asks = sorted(self.asks.items())[:limit]
+        return {
+            "lastUpdateId": self.update_id,
+            "bids": [[f"{p:.2f}", f"{q:.4f}"] for p, q in bids],
+            "asks": [[f"{p:.2f}", f"{q:.4f}"] for p, q in asks],
+        }
+
+    def next_event(self, symbol: str, skip_id: bool) -> dict:
+        first = self.update_id + (2 if skip_id else 1)
+        changes_b, changes_a = [], []
+        for _ in range(random.randint(1, 8)):
+            side, changes = random.choice([(self.bids, changes_b), (self.asks, changes_a)])
+            price = random.choice(list(side.keys()))
+            qty = 0.0 if random.random() < 0.2 else round(random.uniform(0.01, 3.0), 4)
+            if qty == 0.0:
+                side.pop(price, None)
+            else:
+                side[price] = qty
+            changes.append([f"{price:.2f}", f"{qty:.4f}"])
+        last = first + random.randint(0, 3)
+        self.update_id = last
+        return {"e": "depthUpdate", "E": 0, "s": symbol, "U": first, "u": last,
+                "b": changes_b, "a": changes_a}
+
+
+def ws_frame(text: str, opcode: int = 0x1) -> bytes:
+    payload = text.encode()
+    header = bytearray([0x80 | opcode])
+    if len(payload) < 126:
+        header.append(len(payload))
+    elif len(payload) < 65536:
+        header.append(126)
+        header += struct.pack("!H", len(payload))
+    else:
+        header.append(127)
+        header += struct.pack("!Q", len(payload))
+    return bytes(header) + payload
+
+
+async def read_ws_frame(reader):
+    """Returns (opcode, payload) of one client frame (always masked)."""
+    b0, b1 = await reader.readexactly(2)
+    length = b1 & 0x7F
+    if length == 126:
+        length = struct.unpack("!H", await reader.readexactly(2))[0]
+    elif length == 127:
+        length = struct.unpack("!Q", await reader.readexactly(8))[0]
+    mask = await reader.readexactly(4) if b1 & 0x80 else b"\0\0\0\0"
+    data = await reader.readexactly(length)
+    return b0 & 0x0F, bytes(c ^ mask[i % 4] for i, c in enumerate(data))
+
+
+async def serve_control(reader, writer, subscribed):
+    """Applies SUBSCRIBE / UNSUBSCRIBE requests and acknowledges them."""
+    while True:
+        try:
+            opcode, payload = await read_ws_frame(reader)
+        except (asyncio.IncompleteReadError, ConnectionError):
+            return
+        if opcode == 0x8:       # Close
+            return
+        if opcode == 0x9:       # Ping
+            writer.write(ws_frame(payload.decode(errors="ignore"), 0xA))
+            continue
+        if opcode != 0x1:
+            continue
+        try:
+            request = json.loads(payload)
+        except ValueError:
+            continue
+        streams = request.get("params", [])
+        if request.get("method") == "SUBSCRIBE":
+            subscribed.update(streams)
+        elif request.get("method") == "UNSUBSCRIBE":
+            subscribed.difference_update(streams)
+        writer.write(ws_frame(json.dumps({"result": None, "id": request.get("id")})))
+        await writer.drain()
+
+
+async def handle(reader, writer, books, args):
+    request = await reader.readuntil(b"\r\n\r\n")
+    lines = request.decode(errors="ignore").split("\r\n")
+    method, target, _ = lines[0].split(" ", 2)
+    headers = {k.strip().lower(): v.strip() for k, v in
+               (line.split(":", 1) for line in lines[1:] if ":" in line)}
+    url = urlparse(target)
+
+    if url.path == "/api/v3/depth":
+        params = parse_qs(url.query)
+        symbol = params.get("symbol", ["BTCUSDT"])[0]
+        limit = int(params.get("limit", ["100"])[0])
+        book = books.setdefault(symbol, SyntheticBook(args.mid, args.tick))
+        body = json.dumps(book.snapshot(limit)).encode()
+        writer.write(b"HTTP/1.1 200 OK\r\nContent-Type: application/json\r\n"
+                     + f"Content-Length: {len(body)}\r\nConnection: close\r\n\r\n".encode() + body)
+        await writer.drain()
+        writer.close()
+        return
+
+    if url.path == "/stream" and "sec-websocket-key" in headers:
+        accept = base64.b64encode(hashlib.sha1(
+            (headers["sec-websocket-key"] + WS_GUID).encode()).digest()).decode()
+        writer.write(("HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\n"
+                      f"Connection: Upgrade\r\nSec-WebSocket-Accept: {accept}\r\n\r\n").encode())
+        subscribed = set()
+        sent = {}
+        control = asyncio.ensure_future(serve_control(reader, writer, subscribed))
+        try:
+            while not control.done():
+                for stream in sorted(subscribed):
+                    if not stream.endswith("@depth@100ms"):
+                        continue
+                    symbol = stream.split("@")[0].upper()
+                    book = books.setdefault(symbol, SyntheticBook(args.mid, args.tick))
+                    sent[stream] = sent.get(stream, 0) + 1
+                    skip = args.gap_every > 0 and sent[stream] % args.gap_every == 0
+                    event = book.next_event(symbol, skip)
+                    writer.write(ws_frame(json.dumps({"stream": stream, "data": event})))
+                await writer.drain()
+                await asyncio.sleep(args.interval_ms / 1000.0)
+        except (ConnectionError, asyncio.CancelledError):
+            pass
+        finally:
+            control.cancel()
+            writer.close()
+        return
+
+    writer.write(b"HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n")
+    await writer.drain()
+    writer.close()
+
+
+async def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    parser.add_argument("--port", type=int, default=8765)
+    parser.add_argument("--mid", type=float, default=65000.0)
+    parser.add_argument("--tick", type=float, default=0.01)
+    parser.add_argument("--interval-ms", type=int, default=100)
+    parser.add_argument("--gap-every", type=int, default=0)
+    args = parser.parse_args()
+
+    books = {}
+    server = await asyncio.start_server(lambda r, w: handle(r, w, books, args), "127.0.0.1", args.port)
+    print(f"Depth stand-in listening on 127.0.0.1:{args.port}")
+    async with server:
+        await server.serve_forever()
+
+
+if __name__ == "__main__":
+    asyncio.run(main())
@@ -0,0 +1,218 @@
+#include "BinanceAdapter.h"
+#include "SaxParsers.h"
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+namespace {
+
+std::string_view toView(const QByteArray& payload) {
+    return std::string_view(payload.constData(), static_cast<size_t>(payload.size()));
+}
+
+QString toQString(const ShortText& text) {
+    return QString::fromLatin1(text.data, static_cast<qsizetype>(text.size));
+}
+
+} // namespace
+
+BinanceAdapter::BinanceAdapter(const QString& restBaseUrl, const QString& streamBaseUrl)
+    : m_restBaseUrl(restBaseUrl)
+    , m_streamBaseUrl(streamBaseUrl)
+{
+}
+
+int BinanceAdapter::depthWeight(int limit) {
+    if (limit <= 100) return 5;
+    if (limit <= 500) return 25;
+    if (limit <= 1000) return 50;
+    return 250;
+}
+
+// ==========================================
+// Symbols
+// ==========================================
+
+QString BinanceAdapter::exchangeSymbol(const QString& symbol) const {
+    return symbol.toUpper() + QUOTE_ASSET;
+}
+
+QString BinanceAdapter::symbolFromExchange(const QString& exchangeSymbol) const {
+    QString symbol = exchangeSymbol;
+    if (symbol.endsWith(QUOTE_ASSET)) symbol.chop(static_cast<int>(qstrlen(QUOTE_ASSET)));
+    return symbol;
+}
+
+// ==========================================
+// REST
+// ==========================================
+
+ExchangeAdapter::RestCall BinanceAdapter::makeCall(Endpoint endpoint, const QString& symbol,
+                                                   const QString& pathAndQuery, int weight) const {
+    RestCall call;
+    call.endpoint = endpoint;
+    call.exchangeSymbol = exchangeSymbol(symbol);
+    call.url = QUrl(m_restBaseUrl + pathAndQuery);
+    call.weight = weight;
+    return call;
+}
+
+ExchangeAdapter::RestCall BinanceAdapter::depthCall(const QString& symbol, int limit) const {
+    RestCall call = makeCall(Endpoint::Depth, symbol,
+                             QString("/api/v3/depth?symbol=%1&limit=%2").arg(exchangeSymbol(symbol)).arg(limit),
+                             depthWeight(limit));
+    call.limit = limit;
+    return call;
+}
+
+ExchangeAdapter::RestCall BinanceAdapter::klinesCall(const QString& symbol, const QString& interval, int limit,
+                                                     qint64 endTime) const {
+    QString path = QString("/api/v3/klines?symbol=%1&interval=%2&limit=%3")
+                       .arg(exchangeSymbol(symbol), interval).arg(limit);
+    if (endTime > 0) path += QString("&endTime=%1").arg(endTime);
+    RestCall call = makeCall(Endpoint::Klines, symbol, path, KLINES_WEIGHT);
+    call.interval = interval;
+    call.limit = limit;
+    call.endTime = endTime;
+    return call;
+}
+
+ExchangeAdapter::RestCall BinanceAdapter::tickerCall(const QString& symbol) const {
+    return makeCall(Endpoint::Ticker24h, symbol,
+                    QString("/api/v3/ticker/24hr?symbol=%1").arg(exchangeSymbol(symbol)), TICKER_WEIGHT);
+}
+
+ExchangeAdapter::RestCall BinanceAdapter::exchangeInfoCall(const QString& symbol) const {
+    return makeCall(Endpoint::ExchangeInfo, symbol,
+                    QString("/api/v3/exchangeInfo?symbol=%1").arg(exchangeSymbol(symbol)), EXCHANGE_INFO_WEIGHT);
+}
+
+// ==========================================
+// Streams
+// ==========================================
+
+QUrl BinanceAdapter::streamUrl() const {
+    return QUrl(m_streamBaseUrl + "/stream");
+}
+
+QString BinanceAdapter::streamName(MarketStream stream, const QString& symbol, const QString& interval) const {
+    QString pair = exchangeSymbol(symbol).toLower();
+    switch (stream) {
+    case MarketStream::Depth:     return pair + "@depth@100ms";
+    case MarketStream::Kline:     return pair + "@kline_" + interval;
+    case MarketStream::Ticker24h: return pair + "@ticker";
+    case MarketStream::Trade:     return pair + "@aggTrade";
+    }
+    return QString();
+}
+
+QByteArray BinanceAdapter::streamControl(bool subscribe, const QStringList& streams, int id) const {
+    QJsonObject request;
+    request["method"] = subscribe ? "SUBSCRIBE" : "UNSUBSCRIBE";
+    request["params"] = QJsonArray::fromStringList(streams);
+    request["id"] = id;
+    return QJsonDocument(request).toJson(QJsonDocument::Compact);
+}
+
+void BinanceAdapter::describeFrame(const QByteArray& frame, QByteArray& pair, QByteArray& stream) const {
+    // Envelope starts with {"stream":"btcusdt@depth@100ms",...
+    stream.clear();
+    const int start = frame.indexOf("\"stream\":\"");
+    if (start >= 0 && start < 16) {
+        const int from = start + 10;
+        stream = frame.mid(from, frame.indexOf('"', from) - from);
+    }
+    pair = stream.left(stream.indexOf('@')).toUpper();
+}
+
+// ==========================================
+// Decoders
+// ==========================================
+
+bool BinanceAdapter::decodeDepth(const QByteArray& payload, DepthSnapshot& out) const {
+    // An error body ({"code":..,"msg":..}) parses fine but carries no update id
+    return MarketSaxParser::parseDepthSnapshot(toView(payload), out) && out.lastUpdateId > 0;
+}
+
+bool BinanceAdapter::decodeKlines(const QByteArray& payload, std::vector<Kline>& out) const {
+    // Per-worker scratch buffer, reused across replies
+    thread_local std::vector<Candle> candles;
+    if (!MarketSaxParser::parseKlines(toView(payload), candles)) return false;
+
+    out.reserve(candles.size());
+    for (const Candle& c : candles) {
+        Kline kline;
+        kline.openTime = c.openTime;
+        kline.open = c.open;
+        kline.high = c.high;
+        kline.low = c.low;
+        kline.close = c.close;
+        kline.volume = c.volume;
+        out.push_back(kline);
+    }
+    return true;
+}
+
+bool BinanceAdapter::decodeTicker(const QByteArray& payload, Ticker24h& out) const {
+    TickerStats stats;
+    ShortText symbol;
+    if (!MarketSaxParser::parseTicker(toView(payload), stats, symbol)) return false;
+
+    out.symbol = toQString(symbol);
+    out.lastPrice = stats.lastPrice;
+    out.priceChange = stats.priceChange;
+    out.priceChangePercent = stats.priceChangePercent;
+    out.quoteVolume = stats.quoteVolume;
+    return true;
+}
+
+bool BinanceAdapter::decodeExchangeInfo(const QByteArray& payload, std::vector<SymbolInfo>& out) const {
+    return SymbolRegistry::parseExchangeInfo(payload, out);
+}
+
+bool BinanceAdapter::decodeStream(const QByteArray& payload, StreamMessage& out) const {
+    // Per-worker scratch event: its level vectors keep their capacity
+    thread_local StreamEvent event;
+    if (!MarketSaxParser::parseStreamEvent(toView(payload), event)) return false;
+
+    // SUBSCRIBE acknowledgements ({"result": null, "id": n}) carry no event
+    switch (event.type) {
+    case StreamEvent::Type::Depth:
+        out.type = StreamMessage::Type::Depth;
+        out.depth = event.depth;
+        break;
+    case StreamEvent::Type::Kline:
+        out.type = StreamMessage::Type::Kline;
+        out.kline.interval = toQString(event.klineInterval);
+        out.kline.openTime = event.kline.openTime;
+        out.kline.open = event.kline.open;
+        out.kline.high = event.kline.high;
+        out.kline.low = event.kline.low;
+        out.kline.close = event.kline.close;
+        out.kline.volume = event.kline.volume;
+        out.kline.closed = event.klineClosed;
+        break;
+    case StreamEvent::Type::Ticker:
+        out.type = StreamMessage::Type::Ticker;
+        out.ticker.lastPrice = event.ticker.lastPrice;
+        out.ticker.priceChange = event.ticker.priceChange;
+        out.ticker.priceChangePercent = event.ticker.priceChangePercent;
+        out.ticker.quoteVolume = event.ticker.quoteVolume;
+        break;
+    case StreamEvent::Type::Trade:
+        out.type = StreamMessage::Type::Trade;
+        out.trade.tradeId = event.trade.tradeId;
+        out.trade.timeMs = event.trade.timeMs;
+        out.trade.price = event.trade.price;
+        out.trade.qty = event.trade.qty;
+        out.trade.buyerIsMaker = event.trade.buyerIsMaker;
+        break;
+    case StreamEvent::Type::None:
+        out.type = StreamMessage::Type::None;
+        return true;
+    }
+
+    out.exchangeSymbol = toQString(event.symbol);
+    out.eventTimeMs = event.eventTimeMs;
+    return true;
+}
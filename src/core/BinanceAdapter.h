@@ -0,0 +1,64 @@
+/**
+ * @file BinanceAdapter.h
+ * @brief ExchangeAdapter for Binance spot (USDT pairs).
+ *
+ * REST: /api/v3/depth, /klines, /ticker/24hr and /exchangeInfo. Streams go
+ * through one combined-stream WebSocket (`/stream`) with SUBSCRIBE /
+ * UNSUBSCRIBE control frames. Payloads are decoded with the SAX parsers of
+ * SaxParsers.h.
+ */
+
+#ifndef BINANCEADAPTER_H
+#define BINANCEADAPTER_H
+
+#include "ExchangeAdapter.h"
+
+/**
+ * @class BinanceAdapter
+ * @brief Binance spot symbols, endpoints, request weights and wire format.
+ */
+class BinanceAdapter : public ExchangeAdapter {
+public:
+    static constexpr const char* DEFAULT_REST_URL = "https://api.binance.com";
+    static constexpr const char* DEFAULT_STREAM_URL = "wss://stream.binance.com:9443";
+    static constexpr const char* QUOTE_ASSET = "USDT";
+
+    // REST request weights (spot API)
+    static constexpr int KLINES_WEIGHT = 2;
+    static constexpr int TICKER_WEIGHT = 2;            // Single-symbol /ticker/24hr
+    static constexpr int EXCHANGE_INFO_WEIGHT = 20;
+    static int depthWeight(int limit);
+
+    /// Base URLs can point at a local stand-in server.
+    explicit BinanceAdapter(const QString& restBaseUrl = DEFAULT_REST_URL,
+                            const QString& streamBaseUrl = DEFAULT_STREAM_URL);
+
+    QString name() const override { return "binance"; }
+
+    QString exchangeSymbol(const QString& symbol) const override;
+    QString symbolFromExchange(const QString& exchangeSymbol) const override;
+
+    RestCall depthCall(const QString& symbol, int limit) const override;
+    RestCall klinesCall(const QString& symbol, const QString& interval, int limit, qint64 endTime) const override;
+    RestCall tickerCall(const QString& symbol) const override;
+    RestCall exchangeInfoCall(const QString& symbol) const override;
+
+    QUrl streamUrl() const override;
+    QString streamName(MarketStream stream, const QString& symbol, const QString& interval) const override;
+    QByteArray streamControl(bool subscribe, const QStringList& streams, int id) const override;
+    void describeFrame(const QByteArray& frame, QByteArray& pair, QByteArray& stream) const override;
+
+    bool decodeDepth(const QByteArray& payload, DepthSnapshot& out) const override;
+    bool decodeKlines(const QByteArray& payload, std::vector<Kline>& out) const override;
+    bool decodeTicker(const QByteArray& payload, Ticker24h& out) const override;
+    bool decodeExchangeInfo(const QByteArray& payload, std::vector<SymbolInfo>& out) const override;
+    bool decodeStream(const QByteArray& payload, StreamMessage& out) const override;
+
+private:
+    RestCall makeCall(Endpoint endpoint, const QString& symbol, const QString& pathAndQuery, int weight) const;
+
+    QString m_restBaseUrl;
+    QString m_streamBaseUrl;
+};
+
+#endif // BINANCEADAPTER_H
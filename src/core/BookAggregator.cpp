@@ -0,0 +1,29 @@
+#include "BookAggregator.h"
+#include <vector>
+
+void BookAggregator::rebuild(const L2Book& book) {
+    std::vector<BookLevel> bids, asks;
+
+    // Levels come best first and bucketing is monotonic: equal buckets are adjacent
+    auto group = [this, &book](BookSide side, std::vector<BookLevel>& out) {
+        const size_t depth = book.depth(side);
+        out.reserve(depth / 4 + 1);
+        for (size_t i = 0; i < depth; ++i) {
+            const BookLevel& lvl = book.level(side, i);
+            const Price bucket = bucketOf(side, lvl.price);
+            if (!out.empty() && out.back().price == bucket) out.back().qty += lvl.qty;
+            else out.push_back({bucket, lvl.qty});
+        }
+    };
+    group(BookSide::Bid, bids);
+    group(BookSide::Ask, asks);
+    m_buckets.applySnapshot(bids, asks);
+}
+
+void BookAggregator::applyChange(BookSide side, Price price, Qty previous, Qty qty) {
+    if (previous == qty) return;
+
+    const Price bucket = bucketOf(side, price);
+    const Qty total = m_buckets.quantityAt(side, bucket) - previous + (qty.isPositive() ? qty : Qty());
+    m_buckets.setLevel(side, bucket, total);
+}
@@ -0,0 +1,47 @@
+/**
+ * @file BookAggregator.h
+ * @brief Price-level grouping of an L2Book, maintained incrementally.
+ *
+ * Levels are grouped into buckets of a fixed step (bids floored, asks
+ * ceiled to the step, so a bucket never crosses the spread). Bucket totals
+ * are kept in an L2Book of their own and updated from each level change:
+ * a change costs one bucket lookup, not a regroup of the whole book. Only a
+ * step change or a book reset rebuilds from scratch.
+ */
+
+#ifndef BOOKAGGREGATOR_H
+#define BOOKAGGREGATOR_H
+
+#include "L2Book.h"
+
+/**
+ * @class BookAggregator
+ * @brief Grouped view of an L2Book at a user-chosen step.
+ */
+class BookAggregator {
+public:
+    /// Changes the bucket size. Call rebuild() afterwards.
+    void setStep(Price step) { m_step = step; }
+    Price step() const { return m_step; }
+
+    /// Regroups every level of @p book.
+    void rebuild(const L2Book& book);
+
+    /// Accounts for one level going from @p previous to @p qty (either may be zero).
+    void applyChange(BookSide side, Price price, Qty previous, Qty qty);
+
+    void clear() { m_buckets.clear(); }
+
+    /// Buckets, keyed by their rounded price.
+    const L2Book& buckets() const { return m_buckets; }
+
+private:
+    Price bucketOf(BookSide side, Price price) const {
+        return side == BookSide::Bid ? price.floorTo(m_step) : price.ceilTo(m_step);
+    }
+
+    Price m_step = Price::fromRaw(1000000);     // 0.01
+    L2Book m_buckets;
+};
+
+#endif // BOOKAGGREGATOR_H
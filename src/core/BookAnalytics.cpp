@@ -0,0 +1,113 @@
+#include "BookAnalytics.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+/// Top-of-side reductions over the TOP_LEVELS best levels.
+struct SideScan {
+    double qty = 0;
+    double vwap = 0;
+    double slope = 0;
+};
+
+SideScan scanTop(const std::vector<BookLevel>& levels, double mid) {
+    constexpr size_t N = BookAnalytics::TOP_LEVELS;
+    double price[N], qty[N], distance[N], cumulative[N];
+
+    // Gather best first into flat arrays, then reduce them in plain loops
+    const size_t n = std::min(N, levels.size());
+    const BookLevel* best = levels.data() + levels.size() - 1;
+    for (size_t i = 0; i < n; ++i) {
+        price[i] = static_cast<double>((best - i)->price.raw()) / Price::SCALE;
+        qty[i] = static_cast<double>((best - i)->qty.raw()) / Qty::SCALE;
+    }
+
+    SideScan scan;
+    double notional = 0;
+    for (size_t i = 0; i < n; ++i) {
+        scan.qty += qty[i];
+        notional += price[i] * qty[i];
+        distance[i] = std::abs(price[i] - mid) / mid * 10000.0;
+    }
+    if (scan.qty > 0) scan.vwap = notional / scan.qty;
+
+    // Least-squares slope of cumulative size against distance (bps)
+    double running = 0;
+    for (size_t i = 0; i < n; ++i) {
+        running += qty[i];
+        cumulative[i] = running;
+    }
+    double sx = 0, sy = 0;
+    for (size_t i = 0; i < n; ++i) {
+        sx += distance[i];
+        sy += cumulative[i];
+    }
+    if (n > 1) {
+        const double mx = sx / n, my = sy / n;
+        double sxy = 0, sxx = 0;
+        for (size_t i = 0; i < n; ++i) {
+            sxy += (distance[i] - mx) * (cumulative[i] - my);
+            sxx += (distance[i] - mx) * (distance[i] - mx);
+        }
+        if (sxx > 0) scan.slope = sxy / sxx;
+    }
+    return scan;
+}
+
+/// Base quantity of the levels within each band, widest band last.
+void bandDepth(BookSide side, const std::vector<BookLevel>& levels, double mid, double* out) {
+    // Levels are sorted worst to best: each band is a suffix of the array
+    size_t end = levels.size();
+    int64_t total = 0;
+    for (int b = 0; b < BookStats::BANDS; ++b) {
+        const double offset = mid * BookAnalytics::DEPTH_BANDS_BPS[b] / 10000.0;
+        const int64_t edge = Price::fromDouble(side == BookSide::Bid ? mid - offset : mid + offset).raw();
+        const auto first = std::partition_point(levels.begin(), levels.begin() + end, [&](const BookLevel& lvl) {
+            return side == BookSide::Bid ? lvl.price.raw() < edge : lvl.price.raw() > edge;
+        });
+        const size_t begin = static_cast<size_t>(first - levels.begin());
+        for (size_t i = begin; i < end; ++i) total += levels[i].qty.raw();
+        out[b] = static_cast<double>(total) / Qty::SCALE;
+        end = begin;
+    }
+}
+
+} // namespace
+
+BookStats BookAnalytics::compute(const L2Book& book) {
+    BookStats stats;
+    const BookLevel* bid = book.bestBid();
+    const BookLevel* ask = book.bestAsk();
+    if (!bid || !ask) return stats;
+
+    stats.valid = true;
+    stats.bestBid = bid->price.toDouble();
+    stats.bestAsk = ask->price.toDouble();
+    stats.spread = stats.bestAsk - stats.bestBid;
+    stats.mid = (stats.bestBid + stats.bestAsk) / 2.0;
+
+    const double bidQty = bid->qty.toDouble();
+    const double askQty = ask->qty.toDouble();
+    stats.microprice = bidQty + askQty > 0
+        ? (stats.bestBid * askQty + stats.bestAsk * bidQty) / (bidQty + askQty)
+        : stats.mid;
+
+    const std::vector<BookLevel>& bids = book.sideLevels(BookSide::Bid);
+    const std::vector<BookLevel>& asks = book.sideLevels(BookSide::Ask);
+    const SideScan b = scanTop(bids, stats.mid);
+    const SideScan a = scanTop(asks, stats.mid);
+    const double topQty = b.qty + a.qty;
+    if (topQty > 0) {
+        stats.imbalance = (b.qty - a.qty) / topQty;
+        stats.weightedMid = (b.vwap * a.qty + a.vwap * b.qty) / topQty;
+    } else {
+        stats.weightedMid = stats.mid;
+    }
+    stats.bidSlope = b.slope;
+    stats.askSlope = a.slope;
+
+    bandDepth(BookSide::Bid, bids, stats.mid, stats.bidDepth);
+    bandDepth(BookSide::Ask, asks, stats.mid, stats.askDepth);
+    return stats;
+}
@@ -0,0 +1,51 @@
+/**
+ * @file BookAnalytics.h
+ * @brief Order book analytics recomputed on every book update.
+ *
+ * Metrics read the L2Book side arrays in place: the top levels are gathered
+ * into small flat double arrays and reduced with branch-free loops the
+ * compiler vectorizes, and depth bands are a binary search for the band
+ * edge followed by a sum over the contiguous run of levels inside it.
+ *
+ * GUI-free; MarketDataHub publishes the results as BookMetrics.
+ */
+
+#ifndef BOOKANALYTICS_H
+#define BOOKANALYTICS_H
+
+#include "L2Book.h"
+
+/**
+ * @struct BookStats
+ * @brief Liquidity and fair-price metrics of one book state.
+ */
+struct BookStats {
+    static constexpr int BANDS = 3;
+
+    bool valid = false;             // Both sides non-empty
+    double bestBid = 0;
+    double bestAsk = 0;
+    double spread = 0;
+    double mid = 0;
+    double microprice = 0;          // Touch prices weighted by the opposite touch size
+    double weightedMid = 0;         // Top-N VWAPs weighted by the opposite side's top-N size
+    double imbalance = 0;           // Top-N (bid - ask) / (bid + ask), in [-1, 1]
+    double bidDepth[BANDS] = {};    // Base quantity within DEPTH_BANDS_BPS of the mid
+    double askDepth[BANDS] = {};
+    double bidSlope = 0;            // Top-N cumulative quantity per bp away from the mid
+    double askSlope = 0;
+};
+
+/**
+ * @class BookAnalytics
+ * @brief Computes BookStats from an L2Book.
+ */
+class BookAnalytics {
+public:
+    static constexpr int TOP_LEVELS = 10;
+    static constexpr int DEPTH_BANDS_BPS[BookStats::BANDS] = {5, 10, 25};
+
+    static BookStats compute(const L2Book& book);
+};
+
+#endif // BOOKANALYTICS_H
@@ -0,0 +1,90 @@
+#include "BookChecksum.h"
+#include <algorithm>
+#include <array>
+
+namespace {
+
+constexpr std::array<uint32_t, 256> makeTable() {
+    std::array<uint32_t, 256> table{};
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t c = i;
+        for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        table[i] = c;
+    }
+    return table;
+}
+
+constexpr std::array<uint32_t, 256> CRC_TABLE = makeTable();
+
+// Longest decimal: sign, 11 integer digits, point, 8 decimals
+constexpr size_t MAX_DECIMAL_CHARS = 21;
+constexpr size_t MAX_TEXT = 2 * BookChecksum::LEVELS * (2 * MAX_DECIMAL_CHARS + 2);
+
+/// Writes @p raw (1e-8 units) as a plain decimal without trailing zeros.
+char* writeDecimal(char* out, int64_t raw) {
+    if (raw < 0) {
+        *out++ = '-';
+        raw = -raw;
+    }
+    char digits[20];
+    int n = 0;
+    int64_t units = raw / Price::SCALE;
+    do {
+        digits[n++] = static_cast<char>('0' + units % 10);
+        units /= 10;
+    } while (units > 0);
+    while (n > 0) *out++ = digits[--n];
+
+    int64_t fraction = raw % Price::SCALE;
+    if (fraction == 0) return out;
+    int width = Price::DECIMALS;
+    while (fraction % 10 == 0) {
+        fraction /= 10;
+        --width;
+    }
+    *out++ = '.';
+    for (int i = width - 1; i >= 0; --i) {
+        out[i] = static_cast<char>('0' + fraction % 10);
+        fraction /= 10;
+    }
+    return out + width;
+}
+
+char* writeLevel(char* out, const BookLevel& level, bool separator) {
+    if (separator) *out++ = ':';
+    out = writeDecimal(out, level.price.raw());
+    *out++ = ':';
+    return writeDecimal(out, level.qty.raw());
+}
+
+} // namespace
+
+uint32_t BookChecksum::crc32(const char* data, size_t size, uint32_t crc) {
+    crc = ~crc;
+    for (size_t i = 0; i < size; ++i) {
+        crc = CRC_TABLE[(crc ^ static_cast<uint8_t>(data[i])) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+uint32_t BookChecksum::compute(const L2Book& book) {
+    BookLevel bids[LEVELS];
+    BookLevel asks[LEVELS];
+    const size_t bidCount = std::min<size_t>(LEVELS, book.depth(BookSide::Bid));
+    const size_t askCount = std::min<size_t>(LEVELS, book.depth(BookSide::Ask));
+    for (size_t i = 0; i < bidCount; ++i) bids[i] = book.level(BookSide::Bid, i);
+    for (size_t i = 0; i < askCount; ++i) asks[i] = book.level(BookSide::Ask, i);
+    return compute(bids, bidCount, asks, askCount);
+}
+
+uint32_t BookChecksum::compute(const BookLevel* bids, size_t bidCount, const BookLevel* asks, size_t askCount) {
+    char text[MAX_TEXT];
+    char* out = text;
+    bidCount = std::min<size_t>(LEVELS, bidCount);
+    askCount = std::min<size_t>(LEVELS, askCount);
+    for (size_t i = 0; i < std::max(bidCount, askCount); ++i) {
+        if (i < bidCount) out = writeLevel(out, bids[i], out != text);
+        if (i < askCount) out = writeLevel(out, asks[i], out != text);
+    }
+    return crc32(text, static_cast<size_t>(out - text));
+}
@@ -0,0 +1,41 @@
+/**
+ * @file BookChecksum.h
+ * @brief CRC32 of the top of an order book, in the project's checksum format.
+ *
+ * The checksummed text interleaves the best levels of both sides, best
+ * first: "bid0.price:bid0.qty:ask0.price:ask0.qty:bid1.price:...", a side
+ * that runs out of levels simply being skipped. The layout is OKX's, but
+ * values are printed from the fixed-point book as plain decimals without
+ * trailing zeros ("64012.5", "0.003"), whereas a venue checksums the exact
+ * strings it sent ("0.0010"). The format is therefore this project's own:
+ * the mock adapter signs its diffs ("cs") with it, and a real venue's
+ * checksum only matches when its text happens to carry no trailing zeros.
+ *
+ * The text is built in a stack buffer: no allocation per update.
+ */
+
+#ifndef BOOKCHECKSUM_H
+#define BOOKCHECKSUM_H
+
+#include "L2Book.h"
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @class BookChecksum
+ * @brief GUI-free CRC32 (IEEE 802.3) over the top levels of a book.
+ */
+class BookChecksum {
+public:
+    static constexpr int LEVELS = 25;       // Per side
+
+    static uint32_t crc32(const char* data, size_t size, uint32_t crc = 0);
+
+    /// Checksum of the LEVELS best levels of each side.
+    static uint32_t compute(const L2Book& book);
+
+    /// Same over explicit best-first arrays (at most LEVELS are read per side).
+    static uint32_t compute(const BookLevel* bids, size_t bidCount, const BookLevel* asks, size_t askCount);
+};
+
+#endif // BOOKCHECKSUM_H
@@ -0,0 +1,111 @@
+#include "BookShard.h"
+#include <QDebug>
+
+BookShard::BookShard(int index, QObject* parent)
+    : QObject(parent)
+    , m_index(index)
+{
+}
+
+void BookShard::resetBook(const QString& symbol) {
+    std::shared_ptr<Book>& book = m_books[symbol];
+    if (!book) book = std::make_shared<Book>();
+    book->sync.reset();
+}
+
+void BookShard::removeBook(const QString& symbol) {
+    m_books.remove(symbol);
+}
+
+void BookShard::setDisplayed(const QString& symbol, bool displayed) {
+    auto it = m_books.find(symbol);
+    if (it == m_books.end()) return;
+    Book& book = *it.value();
+    book.displayed = displayed;
+
+    // Every new viewer (not just the first) needs a full book before the changes
+    if (displayed && book.sync.isSynced()) publishBook(symbol, book);
+}
+
+void BookShard::applySnapshot(const QString& symbol, const DepthSnapshot& snapshot) {
+    auto it = m_books.find(symbol);
+    if (it == m_books.end()) return;
+    Book& book = *it.value();
+
+    if (!book.sync.applySnapshot(snapshot)) {
+        // Buffered diffs are already past this snapshot
+        emit snapshotNeeded(symbol);
+        publishMetrics(symbol, book);
+        return;
+    }
+    emit bookSynced(symbol);
+    if (book.displayed) publishBook(symbol, book);
+    publishMetrics(symbol, book);
+}
+
+void BookShard::applyDiff(const QString& symbol, const DepthDiff& diff) {
+    auto it = m_books.find(symbol);
+    if (it == m_books.end()) return;
+    Book& book = *it.value();
+
+    switch (book.sync.applyDiff(diff)) {
+    case DepthSync::Result::Applied:
+        if (book.displayed) publishChanges(symbol, book, diff);
+        publishMetrics(symbol, book);
+        break;
+    case DepthSync::Result::Mismatch:
+        // Viewers keep mirroring the local book until the snapshot replaces it
+        qDebug() << "Depth checksum mismatch, resyncing" << symbol;
+        if (book.displayed) publishChanges(symbol, book, diff);
+        emit snapshotNeeded(symbol);
+        publishMetrics(symbol, book);
+        break;
+    case DepthSync::Result::Gap:
+        qDebug() << "Depth stream gap detected, resyncing" << symbol;
+        emit snapshotNeeded(symbol);
+        publishMetrics(symbol, book);
+        break;
+    case DepthSync::Result::Buffered:
+    case DepthSync::Result::Stale:
+        break;
+    }
+}
+
+void BookShard::publishBook(const QString& symbol, const Book& book) {
+    // Full book: subscribers rebuild their copy from it
+    const L2Book& l2 = book.sync.book();
+    BookUpdate update;
+    update.symbol = symbol;
+    update.lastUpdateId = book.sync.lastUpdateId();
+    update.fromStream = true;
+    update.reset = true;
+    l2.top(BookSide::Bid, l2.depth(BookSide::Bid), update.bids);
+    l2.top(BookSide::Ask, l2.depth(BookSide::Ask), update.asks);
+    emit bookUpdated(update);
+}
+
+void BookShard::publishChanges(const QString& symbol, const Book& book, const DepthDiff& diff) {
+    BookUpdate update;
+    update.symbol = symbol;
+    update.lastUpdateId = book.sync.lastUpdateId();
+    update.fromStream = true;
+    update.reset = false;
+    update.bids = diff.bids;
+    update.asks = diff.asks;
+    emit bookUpdated(update);
+}
+
+void BookShard::publishMetrics(const QString& symbol, const Book& book) {
+    BookMetrics metrics;
+    metrics.symbol = symbol;
+    metrics.lastUpdateId = book.sync.lastUpdateId();
+    metrics.stats = BookAnalytics::compute(book.sync.book());
+
+    const DepthSync& sync = book.sync;
+    metrics.integrity.checksum = sync.checksum();
+    metrics.integrity.resyncing = sync.isResyncing();
+    metrics.integrity.gaps = sync.gapCount();
+    metrics.integrity.checksumFailures = sync.checksumFailures();
+    metrics.integrity.resyncs = sync.resyncCount();
+    emit bookMetricsUpdated(metrics);
+}
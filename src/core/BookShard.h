@@ -0,0 +1,81 @@
+/**
+ * @file BookShard.h
+ * @brief Worker-thread owner of a subset of the live order books.
+ *
+ * MarketDataHub keeps several books in sync at once and pins each symbol to
+ * one shard (hash of the symbol), so all events of a book are applied in
+ * order on the same thread while different books progress in parallel.
+ * The hub posts work with post(); results come back as signals, which Qt
+ * queues to the hub thread.
+ *
+ * Every applied update produces BookMetrics, and so does losing sync (gap
+ * or checksum mismatch) so viewers can flag the stale book right away.
+ * BookUpdates (the full book or the level changes) are only produced for
+ * displayed symbols: books kept live in the background never reach the GUI
+ * until a widget shows them, and each new viewer gets a full book at once.
+ */
+
+#ifndef BOOKSHARD_H
+#define BOOKSHARD_H
+
+#include <QHash>
+#include <QMetaObject>
+#include <QObject>
+#include <QString>
+#include <memory>
+#include <utility>
+#include "DepthSync.h"
+#include "MarketEvents.h"
+
+/**
+ * @class BookShard
+ * @brief DepthSync books of the symbols hashed to one worker thread.
+ */
+class BookShard : public QObject {
+    Q_OBJECT
+
+public:
+    explicit BookShard(int index, QObject* parent = nullptr);
+
+    int index() const { return m_index; }
+
+    /// Runs @p work on the shard thread, after everything posted before it.
+    template <typename Work>
+    void post(Work&& work) {
+        QMetaObject::invokeMethod(this, std::forward<Work>(work), Qt::QueuedConnection);
+    }
+
+    // Shard thread only -------------------------------------------------
+
+    /// Creates the book if needed and drops its content (awaits a snapshot).
+    void resetBook(const QString& symbol);
+    void removeBook(const QString& symbol);
+
+    /// Displayed books publish BookUpdates; each call with @p displayed publishes the book if synced.
+    void setDisplayed(const QString& symbol, bool displayed);
+
+    void applySnapshot(const QString& symbol, const DepthSnapshot& snapshot);
+    void applyDiff(const QString& symbol, const DepthDiff& diff);
+
+signals:
+    void bookUpdated(const BookUpdate& update);
+    void bookMetricsUpdated(const BookMetrics& metrics);
+    void bookSynced(const QString& symbol);
+    /// The book lost sync (gap, checksum mismatch, or snapshot older than the buffered events).
+    void snapshotNeeded(const QString& symbol);
+
+private:
+    struct Book {
+        DepthSync sync;
+        bool displayed = false;
+    };
+
+    void publishBook(const QString& symbol, const Book& book);
+    void publishChanges(const QString& symbol, const Book& book, const DepthDiff& diff);
+    void publishMetrics(const QString& symbol, const Book& book);
+
+    int m_index;
+    QHash<QString, std::shared_ptr<Book>> m_books;
+};
+
+#endif // BOOKSHARD_H
@@ -0,0 +1,93 @@
+#include "CandleBuffer.h"
+#include <algorithm>
+
+void CandleBuffer::clear() {
+    m_time.clear();
+    m_open.clear();
+    m_high.clear();
+    m_low.clear();
+    m_close.clear();
+    m_volume.clear();
+}
+
+void CandleBuffer::reserve(size_t count) {
+    m_time.reserve(count);
+    m_open.reserve(count);
+    m_high.reserve(count);
+    m_low.reserve(count);
+    m_close.reserve(count);
+    m_volume.reserve(count);
+}
+
+void CandleBuffer::append(const Candle& candle) {
+    m_time.push_back(candle.openTime);
+    m_open.push_back(candle.open);
+    m_high.push_back(candle.high);
+    m_low.push_back(candle.low);
+    m_close.push_back(candle.close);
+    m_volume.push_back(candle.volume);
+}
+
+void CandleBuffer::prepend(const std::vector<Candle>& older) {
+    // One shift of each column, then the new candles written in place
+    const size_t count = older.size();
+    m_time.insert(m_time.begin(), count, 0);
+    m_open.insert(m_open.begin(), count, 0.0);
+    m_high.insert(m_high.begin(), count, 0.0);
+    m_low.insert(m_low.begin(), count, 0.0);
+    m_close.insert(m_close.begin(), count, 0.0);
+    m_volume.insert(m_volume.begin(), count, 0.0);
+    for (size_t i = 0; i < count; ++i) {
+        m_time[i] = older[i].openTime;
+        set(i, older[i]);
+    }
+}
+
+CandleBuffer::Upsert CandleBuffer::upsert(const Candle& candle) {
+    if (m_time.empty() || candle.openTime > m_time.back()) {
+        append(candle);
+        return Upsert::Appended;
+    }
+
+    // Almost always the live candle; older ones only change when a backfill finalises them
+    const size_t i = candle.openTime == m_time.back() ? m_time.size() - 1 : lowerBound(candle.openTime);
+    if (i == m_time.size() || m_time[i] != candle.openTime) return Upsert::Ignored;
+    set(i, candle);
+    return Upsert::Updated;
+}
+
+Candle CandleBuffer::at(size_t i) const {
+    Candle candle;
+    candle.openTime = m_time[i];
+    candle.open = m_open[i];
+    candle.high = m_high[i];
+    candle.low = m_low[i];
+    candle.close = m_close[i];
+    candle.volume = m_volume[i];
+    return candle;
+}
+
+size_t CandleBuffer::lowerBound(int64_t time) const {
+    return static_cast<size_t>(std::lower_bound(m_time.begin(), m_time.end(), time) - m_time.begin());
+}
+
+size_t CandleBuffer::indexAt(int64_t time) const {
+    const auto it = std::upper_bound(m_time.begin(), m_time.end(), time);
+    return it == m_time.begin() ? m_time.size() : static_cast<size_t>(it - m_time.begin()) - 1;
+}
+
+bool CandleBuffer::priceRange(size_t first, size_t last, double& low, double& high) const {
+    last = std::min(last, m_time.size());
+    if (first >= last) return false;
+    low = *std::min_element(m_low.begin() + first, m_low.begin() + last);
+    high = *std::max_element(m_high.begin() + first, m_high.begin() + last);
+    return true;
+}
+
+void CandleBuffer::set(size_t i, const Candle& candle) {
+    m_open[i] = candle.open;
+    m_high[i] = candle.high;
+    m_low[i] = candle.low;
+    m_close[i] = candle.close;
+    m_volume[i] = candle.volume;
+}
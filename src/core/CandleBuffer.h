@@ -0,0 +1,75 @@
+/**
+ * @file CandleBuffer.h
+ * @brief Chart candles stored as a struct of arrays, oldest first.
+ *
+ * One contiguous array per field (open time, open, high, low, close,
+ * volume) instead of one object per candle:
+ * - a million candles are 48 MB of plain doubles, no per-candle allocation
+ * - the visible range is two binary searches on the time array
+ * - renderers and indicators stream only the fields they read
+ *
+ * GUI-free; ChartWidget owns it and CandleItem draws it.
+ */
+
+#ifndef CANDLEBUFFER_H
+#define CANDLEBUFFER_H
+
+#include "MarketTypes.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class CandleBuffer
+ * @brief Time-sorted OHLCV columns with in-place update of the live candle.
+ */
+class CandleBuffer {
+public:
+    enum class Upsert {
+        Appended,   // Newer than the last candle
+        Updated,    // Replaced the candle with the same open time
+        Ignored     // Older than the buffer, or inside it without a match
+    };
+
+    size_t size() const { return m_time.size(); }
+    bool empty() const { return m_time.empty(); }
+    void clear();
+    void reserve(size_t count);
+
+    /// Appends @p candle; its open time must be after lastTime().
+    void append(const Candle& candle);
+    /// Inserts @p older (sorted, all before the first candle) at the front.
+    void prepend(const std::vector<Candle>& older);
+    Upsert upsert(const Candle& candle);
+
+    Candle at(size_t i) const;
+    int64_t lastTime() const { return m_time.empty() ? 0 : m_time.back(); }
+
+    /// First candle opening at or after @p time (size() if none).
+    size_t lowerBound(int64_t time) const;
+
+    /// Candle whose slot contains @p time: the last one opening at or before it (size() if none).
+    size_t indexAt(int64_t time) const;
+
+    /// Lowest low and highest high over [first, last). @return false if the range is empty.
+    bool priceRange(size_t first, size_t last, double& low, double& high) const;
+
+    const std::vector<int64_t>& times() const { return m_time; }
+    const std::vector<double>& opens() const { return m_open; }
+    const std::vector<double>& highs() const { return m_high; }
+    const std::vector<double>& lows() const { return m_low; }
+    const std::vector<double>& closes() const { return m_close; }
+    const std::vector<double>& volumes() const { return m_volume; }
+
+private:
+    void set(size_t i, const Candle& candle);
+
+    std::vector<int64_t> m_time;
+    std::vector<double> m_open;
+    std::vector<double> m_high;
+    std::vector<double> m_low;
+    std::vector<double> m_close;
+    std::vector<double> m_volume;
+};
+
+#endif // CANDLEBUFFER_H
@@ -0,0 +1,88 @@
+#include "CandleLod.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace {
+
+/// Read-only view of one level's columns (the buffer itself for level 0).
+struct Columns {
+    const double* open;
+    const double* high;
+    const double* low;
+    const double* close;
+    size_t size;
+};
+
+} // namespace
+
+void CandleLod::rebuild(const CandleBuffer& candles) {
+    m_levels.clear();
+    grow(candles.size());
+    // grow() sizes each new level from the one below; fill them bottom-up
+    for (int k = 1; k <= topLevel(); ++k) {
+        for (size_t j = 0; j < level(k).size(); ++j) merge(k, j, candles);
+    }
+}
+
+void CandleLod::update(const CandleBuffer& candles, size_t index) {
+    if (candles.size() < 2) {
+        m_levels.clear();
+        return;
+    }
+
+    for (int k = 1; k <= topLevel(); ++k) merge(k, index >> k, candles);
+
+    // The buffer may have just crossed a power of two
+    const int built = topLevel();
+    grow(candles.size());
+    for (int k = built + 1; k <= topLevel(); ++k) {
+        for (size_t j = 0; j < level(k).size(); ++j) merge(k, j, candles);
+    }
+}
+
+int CandleLod::levelFor(double candlesPerPixel) const {
+    if (!(candlesPerPixel >= 2.0)) return 0;
+    return std::min(std::ilogb(candlesPerPixel), topLevel());
+}
+
+void CandleLod::merge(int k, size_t bucket, const CandleBuffer& candles) {
+    Columns src;
+    if (k == 1) {
+        src = {candles.opens().data(), candles.highs().data(), candles.lows().data(),
+               candles.closes().data(), candles.size()};
+    } else {
+        const Level& below = level(k - 1);
+        src = {below.open.data(), below.high.data(), below.low.data(), below.close.data(), below.size()};
+    }
+
+    Level& dst = m_levels[static_cast<size_t>(k - 1)];
+    if (bucket >= dst.size()) {
+        dst.open.resize(bucket + 1);
+        dst.high.resize(bucket + 1);
+        dst.low.resize(bucket + 1);
+        dst.close.resize(bucket + 1);
+    }
+
+    const size_t first = bucket * 2;
+    const size_t last = std::min(first + 2, src.size);
+    dst.open[bucket] = src.open[first];
+    dst.close[bucket] = src.close[last - 1];
+    dst.high[bucket] = *std::max_element(src.high + first, src.high + last);
+    dst.low[bucket] = *std::min_element(src.low + first, src.low + last);
+}
+
+void CandleLod::grow(size_t candleCount) {
+    // A level exists while the one below it still has more than one bucket
+    while (topLevel() < MAX_LEVEL) {
+        const size_t below = m_levels.empty() ? candleCount : m_levels.back().size();
+        if (below < 2) break;
+        const size_t count = (below + 1) / 2;
+        Level next;
+        next.open.resize(count);
+        next.high.resize(count);
+        next.low.resize(count);
+        next.close.resize(count);
+        m_levels.push_back(std::move(next));
+    }
+}
@@ -0,0 +1,67 @@
+/**
+ * @file CandleLod.h
+ * @brief Level-of-detail pyramid of merged candles over a CandleBuffer.
+ *
+ * Level k holds one merged OHLC bucket per 2^k consecutive candles
+ * (bucket j covers candles [j << k, (j + 1) << k)); level 0 is the buffer
+ * itself. Each level is built from the one below it, so the whole pyramid
+ * costs about one extra buffer of memory and O(n) to build.
+ *
+ * A renderer that shows c candles per pixel picks level floor(log2(c)):
+ * every bucket is then at most one pixel wide and the number of buckets
+ * it walks is bounded by the plot width, whatever the series length.
+ *
+ * Updating one candle touches one bucket per level (O(log n)), which is
+ * what the live candle does on every kline tick. GUI-free.
+ */
+
+#ifndef CANDLELOD_H
+#define CANDLELOD_H
+
+#include "CandleBuffer.h"
+#include <cstddef>
+#include <vector>
+
+/**
+ * @class CandleLod
+ * @brief Power-of-two merged OHLC levels, kept in step with a CandleBuffer.
+ */
+class CandleLod {
+public:
+    static constexpr int MAX_LEVEL = 30;
+
+    /// Merged OHLC columns of one level; bucket j opens at times()[j << k].
+    struct Level {
+        std::vector<double> open;
+        std::vector<double> high;
+        std::vector<double> low;
+        std::vector<double> close;
+
+        size_t size() const { return open.size(); }
+    };
+
+    void clear() { m_levels.clear(); }
+
+    /// Rebuilds every level from @p candles.
+    void rebuild(const CandleBuffer& candles);
+
+    /// Refreshes the buckets covering candle @p index after it was appended or updated.
+    void update(const CandleBuffer& candles, size_t index);
+
+    /// Highest level built; 0 when the buffer has fewer than two candles.
+    int topLevel() const { return static_cast<int>(m_levels.size()); }
+
+    /// Level @p k, 1 <= k <= topLevel().
+    const Level& level(int k) const { return m_levels[static_cast<size_t>(k - 1)]; }
+
+    /// Deepest level whose buckets hold at most @p candlesPerPixel candles.
+    int levelFor(double candlesPerPixel) const;
+
+private:
+    void merge(int k, size_t bucket, const CandleBuffer& candles);
+    void grow(size_t candleCount);
+
+    std::vector<Level> m_levels;    // m_levels[k - 1] is level k
+};
+
+#endif // CANDLELOD_H
@@ -0,0 +1,78 @@
+#include "DepthHeatmap.h"
+#include <algorithm>
+#include <cmath>
+
+void DepthHeatmap::clear() {
+    m_head = 0;
+    m_size = 0;
+    m_binStep = Price();
+    m_maxCode = 0;
+}
+
+uint8_t DepthHeatmap::encode(double qty) {
+    if (qty <= 0) return 0;
+    const double code = std::round(CODES_PER_DOUBLING * std::log2(1.0 + qty / QTY_UNIT));
+    return static_cast<uint8_t>(std::clamp(code, 1.0, 255.0));
+}
+
+bool DepthHeatmap::sample(const L2Book& book, int64_t timeMs, Price tick) {
+    const BookLevel* bid = book.bestBid();
+    const BookLevel* ask = book.bestAsk();
+    if (!bid || !ask) return false;
+
+    const Price mid = Price::fromRaw((bid->price.raw() + ask->price.raw()) / 2);
+    if (!m_binStep.isPositive()) {
+        const Price unit = tick.isPositive() ? tick : Price::fromRaw(1);
+        m_binStep = Price::fromDouble(mid.toDouble() * BIN_FRACTION).ceilTo(unit);
+        if (!m_binStep.isPositive()) m_binStep = unit;
+    }
+
+    // Storage is allocated once, on the first sample
+    if (m_times.empty()) {
+        m_times.resize(CAPACITY);
+        m_firstBins.resize(CAPACITY);
+        m_cells.resize(CAPACITY * BINS);
+        m_accum.resize(BINS);
+    }
+
+    const int64_t firstBin = binOf(mid) - BINS / 2;
+    std::fill(m_accum.begin(), m_accum.end(), 0.0);
+
+    // Walk each side from the touch until it leaves the window
+    for (BookSide side : {BookSide::Bid, BookSide::Ask}) {
+        const size_t depth = book.depth(side);
+        for (size_t i = 0; i < depth; ++i) {
+            const BookLevel& lvl = book.level(side, i);
+            const int64_t k = binOf(lvl.price) - firstBin;
+            if (k < 0 || k >= BINS) break;
+            m_accum[static_cast<size_t>(k)] += lvl.qty.toDouble();
+        }
+    }
+
+    size_t slot;
+    if (m_size < CAPACITY) {
+        slot = (m_head + m_size) % CAPACITY;
+        ++m_size;
+    } else {
+        slot = m_head;      // Overwrite the oldest column
+        m_head = (m_head + 1) % CAPACITY;
+    }
+    m_times[slot] = timeMs;
+    m_firstBins[slot] = firstBin;
+    uint8_t* cells = &m_cells[slot * BINS];
+    for (int k = 0; k < BINS; ++k) {
+        cells[k] = encode(m_accum[static_cast<size_t>(k)]);
+        m_maxCode = std::max(m_maxCode, cells[k]);
+    }
+    return true;
+}
+
+size_t DepthHeatmap::lowerBound(int64_t timeMs) const {
+    size_t lo = 0, hi = m_size;
+    while (lo < hi) {
+        const size_t mid = lo + (hi - lo) / 2;
+        if (m_times[(m_head + mid) % CAPACITY] < timeMs) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
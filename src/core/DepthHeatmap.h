@@ -0,0 +1,86 @@
+/**
+ * @file DepthHeatmap.h
+ * @brief Time x price history of resting depth in a fixed-size columnar ring.
+ *
+ * Every sample is one column: BINS price bins of a fixed step centred on the
+ * mid, each holding the summed quantity of its levels quantized to one byte
+ * on a log scale (CODES_PER_DOUBLING codes per doubling of size). Columns
+ * live in flat arrays (times, first bins, cells) preallocated for
+ * HISTORY_MS at SAMPLE_MS resolution: four hours cost about 39 MB and
+ * memory never grows, the oldest column is overwritten instead.
+ *
+ * GUI-free; rendering is done by HeatmapItem.
+ */
+
+#ifndef DEPTHHEATMAP_H
+#define DEPTHHEATMAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "L2Book.h"
+
+/**
+ * @class DepthHeatmap
+ * @brief Periodic quantized book snapshots of one symbol.
+ */
+class DepthHeatmap {
+public:
+    static constexpr int BINS = 256;                            // Price bins per column
+    static constexpr int64_t SAMPLE_MS = 100;
+    static constexpr int64_t HISTORY_MS = 4 * 3600 * 1000;
+    static constexpr size_t CAPACITY = HISTORY_MS / SAMPLE_MS;  // Columns
+    static constexpr double BIN_FRACTION = 0.0001;              // Bin step, relative to the first mid
+    static constexpr double CODES_PER_DOUBLING = 8;
+    static constexpr double QTY_UNIT = 0.0001;                  // Quantity of code 8
+
+    /// One sample. @c cells[k] is the code of bin @c firstBin + k.
+    struct Column {
+        int64_t time;
+        int64_t firstBin;
+        const uint8_t* cells;
+    };
+
+    /// Drops all columns and the bin step (a new symbol starts over).
+    void clear();
+
+    /**
+     * Appends a column from @p book. The bin step is fixed on the first
+     * sample as a multiple of @p tick.
+     * @return false if either side of the book is empty.
+     */
+    bool sample(const L2Book& book, int64_t timeMs, Price tick);
+
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    /// @p i-th column, oldest first. Requires i < size().
+    Column column(size_t i) const {
+        const size_t slot = (m_head + i) % CAPACITY;
+        return {m_times[slot], m_firstBins[slot], &m_cells[slot * BINS]};
+    }
+    Column newest() const { return column(m_size - 1); }
+
+    /// First column with time >= @p timeMs (size() if none).
+    size_t lowerBound(int64_t timeMs) const;
+
+    Price binStep() const { return m_binStep; }
+    int64_t binOf(Price price) const { return price.floorTo(m_binStep).raw() / m_binStep.raw(); }
+
+    /// Highest code stored so far (0 if none), to normalize colours.
+    uint8_t maxCode() const { return m_maxCode; }
+
+    static uint8_t encode(double qty);
+
+private:
+    std::vector<int64_t> m_times;       // Columnar, CAPACITY slots each
+    std::vector<int64_t> m_firstBins;
+    std::vector<uint8_t> m_cells;       // CAPACITY x BINS, column-major
+    std::vector<double> m_accum;        // Scratch, BINS
+    size_t m_head = 0;                  // Slot of the oldest column
+    size_t m_size = 0;
+    Price m_binStep;
+    uint8_t m_maxCode = 0;
+};
+
+#endif // DEPTHHEATMAP_H
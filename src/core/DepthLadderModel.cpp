@@ -0,0 +1,148 @@
+#include "DepthLadderModel.h"
+#include <algorithm>
+#include <cmath>
+
+DepthLadderModel::DepthLadderModel(BookSide side, QObject* parent)
+    : QAbstractTableModel(parent)
+    , m_side(side)
+{
+}
+
+int DepthLadderModel::rowCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : static_cast<int>(m_rows.size());
+}
+
+int DepthLadderModel::columnCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant DepthLadderModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid() || index.row() >= rowCount()) return QVariant();
+    if (role == Qt::DisplayRole) return text(row(index.row()), index.column());
+    if (role == Qt::TextAlignmentRole) return int(Qt::AlignRight | Qt::AlignVCenter);
+    return QVariant();
+}
+
+QVariant DepthLadderModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) return QVariant();
+    switch (section) {
+    case PriceColumn:  return QStringLiteral("Price");
+    case AmountColumn: return QStringLiteral("Amount");
+    case TotalColumn:  return QStringLiteral("Total");
+    default:           return QVariant();
+    }
+}
+
+QString DepthLadderModel::text(const Row& row, int column) const {
+    switch (column) {
+    case PriceColumn:  return formatNumber(row.price.toDouble(), m_priceDecimals);
+    case AmountColumn: return formatQty(row.qty.toDouble());
+    case TotalColumn:  return formatQty(row.total.toDouble());
+    default:           return QString();
+    }
+}
+
+QString DepthLadderModel::formatNumber(double value, int decimals) {
+    QString str = QString::number(value, 'f', decimals);
+    int pos = str.indexOf('.');
+    if (pos == -1) pos = str.length();
+    while (pos > 3) {
+        pos -= 3;
+        str.insert(pos, ' ');
+    }
+    return str;
+}
+
+void DepthLadderModel::setLevels(const std::vector<BookLevel>& levels) {
+    // Build the new rows in display order, totals cumulative from the best level
+    const size_t n = levels.size();
+    m_next.resize(n);
+    Qty total;
+    for (size_t i = 0; i < n; ++i) {
+        total += levels[i].qty;
+        Row& r = m_next[m_side == BookSide::Ask ? n - 1 - i : i];
+        r.price = levels[i].price;
+        r.qty = levels[i].qty;
+        r.total = total;
+    }
+    m_total = total;
+
+    // Levels appear and vanish at the deep end: bids grow at the bottom, asks
+    // at the top. Insert / remove there so the view keeps its scroll position.
+    const int oldCount = static_cast<int>(m_rows.size());
+    const int newCount = static_cast<int>(n);
+    const bool deepAtTop = m_side == BookSide::Ask;
+    if (newCount > oldCount) {
+        beginInsertRows(QModelIndex(), deepAtTop ? 0 : oldCount, (deepAtTop ? 0 : oldCount) + newCount - oldCount - 1);
+        m_rows.swap(m_next);
+        endInsertRows();
+    } else if (newCount < oldCount) {
+        beginRemoveRows(QModelIndex(), deepAtTop ? 0 : newCount, (deepAtTop ? 0 : newCount) + oldCount - newCount - 1);
+        m_rows.swap(m_next);
+        endRemoveRows();
+    } else {
+        m_rows.swap(m_next);
+    }
+
+    // Diff the rows both generations share, merging adjacent changed rows into
+    // one signal: a deep change shifts every total below it
+    const int shared = std::min(oldCount, newCount);
+    const int newBase = deepAtTop ? newCount - shared : 0;
+    const int oldBase = deepAtTop ? oldCount - shared : 0;
+    int runStart = -1, runFirst = ColumnCount, runLast = -1;
+    for (int i = 0; i <= shared; ++i) {
+        int first = ColumnCount, last = -1;
+        if (i < shared) {
+            const Row& now = m_rows[static_cast<size_t>(newBase + i)];
+            const Row& before = m_next[static_cast<size_t>(oldBase + i)];
+            if (now.price != before.price) { first = PriceColumn; last = PriceColumn; }
+            if (now.qty != before.qty) { first = std::min(first, int(AmountColumn)); last = AmountColumn; }
+            if (now.total != before.total) {
+                // The depth bar spans the whole row
+                first = PriceColumn;
+                last = TotalColumn;
+            }
+        }
+        if (last >= 0) {
+            if (runStart < 0) runStart = i;
+            runFirst = std::min(runFirst, first);
+            runLast = std::max(runLast, last);
+        } else if (runStart >= 0) {
+            emit dataChanged(index(newBase + runStart, runFirst), index(newBase + i - 1, runLast), {Qt::DisplayRole});
+            runStart = -1;
+            runFirst = ColumnCount;
+            runLast = -1;
+        }
+    }
+}
+
+void DepthLadderModel::fitScale(double maxTotal) {
+    if (maxTotal <= 0) return;
+    // Depth moves on almost every diff: only a real change of magnitude rescales
+    if (maxTotal <= m_maxTotal && maxTotal >= m_maxTotal * SCALE_SHRINK_RATIO) return;
+    const double scale = niceCeil(maxTotal);
+    if (scale == m_maxTotal) return;
+    m_maxTotal = scale;
+    // Every bar is relative to the scale
+    emitAllChanged();
+}
+
+double DepthLadderModel::niceCeil(double value) {
+    const double magnitude = std::pow(10.0, std::floor(std::log10(value)));
+    const double mantissa = value / magnitude;
+    if (mantissa <= 1.0) return magnitude;
+    if (mantissa <= 2.0) return 2.0 * magnitude;
+    if (mantissa <= 5.0) return 5.0 * magnitude;
+    return 10.0 * magnitude;
+}
+
+void DepthLadderModel::setPriceDecimals(int decimals) {
+    if (decimals == m_priceDecimals) return;
+    m_priceDecimals = decimals;
+    emitAllChanged();
+}
+
+void DepthLadderModel::emitAllChanged() {
+    if (m_rows.empty()) return;
+    emit dataChanged(index(0, 0), index(rowCount() - 1, ColumnCount - 1), {Qt::DisplayRole});
+}
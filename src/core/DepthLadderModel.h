@@ -0,0 +1,82 @@
+/**
+ * @file DepthLadderModel.h
+ * @brief Table model for one side of the order book ladder.
+ *
+ * Rows are plain structs held in a vector reused across updates. setLevels()
+ * diffs the new rows against the current ones and emits dataChanged only for
+ * the cells whose value moved, so an update allocates nothing and repaints
+ * only what changed. Row totals form a prefix sum over the side, built once
+ * per update: painting a depth bar is a lookup, however deep the ladder.
+ * DepthDelegate reads row() directly instead of going through QVariant
+ * roles; data() is kept for accessibility and tooling.
+ *
+ * Bars are drawn against a scale that only moves in 1-2-5 steps: it grows
+ * as soon as the depth exceeds it but shrinks only after a large drop, so
+ * the full repaint a new scale needs stays rare.
+ */
+
+#ifndef DEPTHLADDERMODEL_H
+#define DEPTHLADDERMODEL_H
+
+#include <QAbstractTableModel>
+#include <vector>
+#include "L2Book.h"
+
+/**
+ * @class DepthLadderModel
+ * @brief Price / Amount / Total rows of one book side, in display order.
+ */
+class DepthLadderModel : public QAbstractTableModel {
+    Q_OBJECT
+
+public:
+    enum Column { PriceColumn, AmountColumn, TotalColumn, ColumnCount };
+
+    static constexpr double SCALE_SHRINK_RATIO = 0.25;  // Shrink once depth falls below this share of the scale
+
+    struct Row {
+        Price price;
+        Qty qty;
+        Qty total;      // Prefix sum of qty from the best level
+    };
+
+    /// Asks are displayed best last (next to the spread), bids best first.
+    explicit DepthLadderModel(BookSide side, QObject* parent = nullptr);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    /// @p levels best first. Emits the minimal row / cell changes.
+    void setLevels(const std::vector<BookLevel>& levels);
+
+    /// Fits the full-width bar scale to @p maxTotal, with hysteresis (see above).
+    void fitScale(double maxTotal);
+    /// Lets the next fitScale() start over (new symbol or grouping).
+    void resetScale() { m_maxTotal = 0; }
+    void setPriceDecimals(int decimals);
+
+    BookSide side() const { return m_side; }
+    const Row& row(int i) const { return m_rows[static_cast<size_t>(i)]; }
+    double scale() const { return m_maxTotal; }
+    Qty total() const { return m_total; }          // Cumulative quantity of all rows
+    int priceDecimals() const { return m_priceDecimals; }
+
+    static QString formatNumber(double value, int decimals);
+    static QString formatQty(double value) { return QString::number(value, 'f', 4); }
+
+private:
+    QString text(const Row& row, int column) const;
+    void emitAllChanged();
+    static double niceCeil(double value);
+
+    BookSide m_side;
+    std::vector<Row> m_rows;
+    std::vector<Row> m_next;        // Scratch, swapped with m_rows
+    Qty m_total;
+    double m_maxTotal = 0;
+    int m_priceDecimals = 2;
+};
+
+#endif // DEPTHLADDERMODEL_H
@@ -0,0 +1,84 @@
+#include "DepthSync.h"
+#include "BookChecksum.h"
+
+void DepthSync::reset() {
+    m_state = State::AwaitingSnapshot;
+    m_lastUpdateId = 0;
+    m_firstEventPending = false;
+    m_resyncing = false;
+    m_checksum = 0;
+    m_buffered.clear();
+    m_book.clear();
+}
+
+bool DepthSync::applySnapshot(const DepthSnapshot& snapshot) {
+    m_book.applySnapshot(snapshot.bids, snapshot.asks);
+    m_checksum = BookChecksum::compute(m_book);
+
+    m_lastUpdateId = snapshot.lastUpdateId;
+    m_state = State::Synced;
+    m_firstEventPending = true;
+    const bool recovering = m_resyncing;
+    m_resyncing = false;
+
+    // Replay everything that arrived while the snapshot was in flight
+    std::deque<DepthDiff> pending;
+    pending.swap(m_buffered);
+    for (const DepthDiff& diff : pending) {
+        const Result result = applyDiff(diff);
+        if (result == Result::Gap || result == Result::Mismatch) {
+            // A gap re-buffered the offending event; keep the newer ones too
+            for (auto it = pending.begin(); it != pending.end(); ++it) {
+                if (it->firstUpdateId > diff.firstUpdateId) m_buffered.push_back(*it);
+            }
+            return false;
+        }
+    }
+    if (recovering) ++m_resyncCount;
+    return true;
+}
+
+DepthSync::Result DepthSync::applyDiff(const DepthDiff& diff) {
+    if (m_state == State::AwaitingSnapshot) {
+        if (m_buffered.size() >= MAX_BUFFERED_EVENTS) m_buffered.pop_front();
+        m_buffered.push_back(diff);
+        return Result::Buffered;
+    }
+
+    if (diff.lastUpdateId <= m_lastUpdateId) {
+        return Result::Stale;
+    }
+
+    // First event after the snapshot must cover lastUpdateId + 1,
+    // afterwards events must be strictly contiguous.
+    bool connected = m_firstEventPending
+        ? diff.firstUpdateId <= m_lastUpdateId + 1
+        : diff.firstUpdateId == m_lastUpdateId + 1;
+
+    if (!connected) {
+        ++m_gapCount;
+        loseSync();
+        m_buffered.push_back(diff);
+        return Result::Gap;
+    }
+
+    m_book.applyChanges(diff.bids, diff.asks);
+    m_lastUpdateId = diff.lastUpdateId;
+    m_firstEventPending = false;
+
+    m_checksum = BookChecksum::compute(m_book);
+    if (diff.hasChecksum && diff.checksum != m_checksum) {
+        ++m_checksumFailures;
+        loseSync();
+        return Result::Mismatch;
+    }
+    return Result::Applied;
+}
+
+void DepthSync::loseSync() {
+    // The book is kept: it stays on screen, flagged, until the next snapshot
+    m_state = State::AwaitingSnapshot;
+    m_firstEventPending = false;
+    m_resyncing = true;
+    m_buffered.clear();
+}
@@ -0,0 +1,88 @@
+/**
+ * @file DepthSync.h
+ * @brief Local order book kept in sync from a REST snapshot plus diff-depth events.
+ *
+ * Implements the standard exchange synchronisation procedure:
+ * - Diff events received before the snapshot are buffered
+ * - Events whose last update id is not newer than the snapshot are dropped
+ * - The first applied event must straddle `lastUpdateId + 1`
+ * - Every following event must start exactly at the previous `u + 1`
+ * - Any gap invalidates the sync; the caller then fetches a new snapshot
+ *
+ * After every change the BookChecksum of the top levels is recomputed. When
+ * the event carries the venue's checksum a mismatch means the local book
+ * drifted, and it is treated like a gap. While resyncing the last book is
+ * kept as is, so it can still be shown (flagged as stale).
+ */
+
+#ifndef DEPTHSYNC_H
+#define DEPTHSYNC_H
+
+#include "L2Book.h"
+#include "MarketTypes.h"
+#include <cstddef>
+#include <deque>
+
+/**
+ * @class DepthSync
+ * @brief GUI-free diff-depth synchroniser holding the full local book.
+ */
+class DepthSync {
+public:
+    enum class State { AwaitingSnapshot, Synced };
+
+    enum class Result {
+        Buffered,   // Waiting for a snapshot, event kept for replay
+        Applied,    // Event applied to the book
+        Stale,      // Event older than the current book, ignored
+        Gap,        // Sequence break, a new snapshot is required
+        Mismatch    // Applied, but the book no longer matches the venue checksum
+    };
+
+    static constexpr size_t MAX_BUFFERED_EVENTS = 2000;
+
+    /// Drops the book and starts buffering events until the next snapshot.
+    void reset();
+
+    /**
+     * Installs a snapshot and replays the buffered events on top of it.
+     * @return false if the buffered events do not connect to the snapshot,
+     *         in which case a newer snapshot must be requested.
+     */
+    bool applySnapshot(const DepthSnapshot& snapshot);
+
+    Result applyDiff(const DepthDiff& diff);
+
+    State state() const { return m_state; }
+    bool isSynced() const { return m_state == State::Synced; }
+    int64_t lastUpdateId() const { return m_lastUpdateId; }
+    int gapCount() const { return m_gapCount; }
+    int checksumFailures() const { return m_checksumFailures; }
+    /// Snapshots installed to recover from a gap or checksum failure.
+    int resyncCount() const { return m_resyncCount; }
+    /// Waiting for a snapshot after losing sync; book() is the last state reached.
+    bool isResyncing() const { return m_resyncing; }
+
+    /// BookChecksum of the book after the last applied snapshot or event.
+    uint32_t checksum() const { return m_checksum; }
+
+    /// Local book; only up to date while synced.
+    const L2Book& book() const { return m_book; }
+
+private:
+    void loseSync();
+
+    State m_state = State::AwaitingSnapshot;
+    int64_t m_lastUpdateId = 0;
+    bool m_firstEventPending = false;
+    bool m_resyncing = false;
+    int m_gapCount = 0;
+    int m_checksumFailures = 0;
+    int m_resyncCount = 0;
+    uint32_t m_checksum = 0;
+
+    std::deque<DepthDiff> m_buffered;
+    L2Book m_book;
+};
+
+#endif // DEPTHSYNC_H
@@ -0,0 +1,108 @@
+/**
+ * @file ExchangeAdapter.h
+ * @brief Venue abstraction: symbols, endpoints, stream protocol and payload decoding.
+ *
+ * MarketDataHub never builds a URL or parses a payload itself. It asks the
+ * active ExchangeAdapter for request descriptions and stream names, and
+ * hands raw payloads back to it to decode into the common structs of
+ * MarketTypes.h / MarketEvents.h. Supporting another venue means writing
+ * another adapter; widgets only ever see application symbols ("BTC").
+ *
+ * Transport:
+ * - Transport::Network adapters are served by the hub's shared
+ *   QNetworkAccessManager (through RequestScheduler) and WebSocket
+ * - Transport::InProcess adapters produce payloads themselves (serve(),
+ *   pollStreams()); the hub calls them directly, no socket is opened
+ *
+ * Decoders are const and thread-safe: they run on FeedDecoder workers.
+ */
+
+#ifndef EXCHANGEADAPTER_H
+#define EXCHANGEADAPTER_H
+
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+#include <QUrl>
+#include <vector>
+#include "MarketEvents.h"
+#include "SymbolRegistry.h"
+
+/**
+ * @struct StreamMessage
+ * @brief Decoded stream event. Symbols are still venue pairs ("BTCUSDT").
+ */
+struct StreamMessage {
+    enum class Type { None, Depth, Kline, Ticker, Trade };
+
+    Type type = Type::None;
+    QString exchangeSymbol;
+    qint64 eventTimeMs = 0;
+    DepthDiff depth;
+    Kline kline;
+    Ticker24h ticker;
+    Trade trade;
+};
+
+/**
+ * @class ExchangeAdapter
+ * @brief Interface implemented once per venue.
+ */
+class ExchangeAdapter {
+public:
+    enum class Transport { Network, InProcess };
+    enum class Endpoint { Depth, Klines, Ticker24h, ExchangeInfo };
+
+    /**
+     * @struct RestCall
+     * @brief One REST request, described independently of its transport.
+     */
+    struct RestCall {
+        Endpoint endpoint = Endpoint::Depth;
+        QString exchangeSymbol;
+        QString interval;           // Klines only
+        int limit = 0;              // Depth levels or candle count
+        qint64 endTime = 0;         // Klines only: newest open time wanted, 0 = up to now
+        QUrl url;                   // Network adapters only
+        int weight = 1;             // Cost against the venue's request budget
+    };
+
+    virtual ~ExchangeAdapter() = default;
+
+    virtual QString name() const = 0;
+    virtual Transport transport() const { return Transport::Network; }
+
+    // Symbols: application symbol ("BTC") <-> venue pair
+    virtual QString exchangeSymbol(const QString& symbol) const = 0;
+    virtual QString symbolFromExchange(const QString& exchangeSymbol) const = 0;
+
+    // REST
+    virtual RestCall depthCall(const QString& symbol, int limit) const = 0;
+    /// @p endTime > 0 pages back: the @p limit candles opening at or before it.
+    virtual RestCall klinesCall(const QString& symbol, const QString& interval, int limit, qint64 endTime) const = 0;
+    virtual RestCall tickerCall(const QString& symbol) const = 0;
+    virtual RestCall exchangeInfoCall(const QString& symbol) const = 0;
+
+    // Streams
+    virtual QUrl streamUrl() const = 0;
+    virtual QString streamName(MarketStream stream, const QString& symbol, const QString& interval) const = 0;
+    /// Control frame (un)subscribing @p streams on an open connection.
+    virtual QByteArray streamControl(bool subscribe, const QStringList& streams, int id) const = 0;
+    /// Cheap routing metadata of a raw frame, for the feed recorder.
+    virtual void describeFrame(const QByteArray& frame, QByteArray& pair, QByteArray& stream) const = 0;
+
+    // Decoders
+    virtual bool decodeDepth(const QByteArray& payload, DepthSnapshot& out) const = 0;
+    virtual bool decodeKlines(const QByteArray& payload, std::vector<Kline>& out) const = 0;
+    virtual bool decodeTicker(const QByteArray& payload, Ticker24h& out) const = 0;
+    virtual bool decodeExchangeInfo(const QByteArray& payload, std::vector<SymbolInfo>& out) const = 0;
+    /// @return false on malformed frames; control frames decode to Type::None.
+    virtual bool decodeStream(const QByteArray& payload, StreamMessage& out) const = 0;
+
+    // In-process transport (hub thread only)
+    virtual QByteArray serve(const RestCall& call) { Q_UNUSED(call); return QByteArray(); }
+    virtual void pollStreams(const QStringList& streams, std::vector<QByteArray>& frames) { Q_UNUSED(streams); Q_UNUSED(frames); }
+    virtual int streamPollIntervalMs() const { return 100; }
+};
+
+#endif // EXCHANGEADAPTER_H
@@ -0,0 +1,90 @@
+#include "FeedDecoder.h"
+#include <QElapsedTimer>
+#include <QThread>
+#include <algorithm>
+
+FeedDecoder::FeedDecoder() {
+    // Leave at least one core to the GUI thread
+    m_pool.setMaxThreadCount(std::clamp(QThread::idealThreadCount() - 1, 1, 4));
+    m_serialPool.setMaxThreadCount(1);
+}
+
+FeedDecoder::~FeedDecoder() {
+    m_pool.waitForDone();
+    m_serialPool.waitForDone();
+}
+
+void FeedDecoder::run(std::function<void()> job) {
+    m_pool.start(std::move(job));
+}
+
+void FeedDecoder::runSerial(std::function<void()> job) {
+    m_serialPool.start(std::move(job));
+}
+
+void FeedDecoder::record(MessageType type, quint64 elapsedNs, bool ok) {
+    Counters& c = m_counters[static_cast<size_t>(type)];
+    c.messages.fetch_add(1, std::memory_order_relaxed);
+    if (!ok) c.failures.fetch_add(1, std::memory_order_relaxed);
+    c.totalNs.fetch_add(elapsedNs, std::memory_order_relaxed);
+
+    quint64 prevMax = c.maxNs.load(std::memory_order_relaxed);
+    while (elapsedNs > prevMax && !c.maxNs.compare_exchange_weak(prevMax, elapsedNs, std::memory_order_relaxed)) {}
+}
+
+DecodeStats FeedDecoder::stats(MessageType type) const {
+    const Counters& c = m_counters[static_cast<size_t>(type)];
+    DecodeStats s;
+    s.messages = c.messages.load(std::memory_order_relaxed);
+    s.failures = c.failures.load(std::memory_order_relaxed);
+    s.totalNs = c.totalNs.load(std::memory_order_relaxed);
+    s.maxNs = c.maxNs.load(std::memory_order_relaxed);
+    return s;
+}
+
+bool FeedDecoder::decodeDepth(const ExchangeAdapter& adapter, const QByteArray& payload, DepthSnapshot& out) {
+    QElapsedTimer timer;
+    timer.start();
+    bool ok = adapter.decodeDepth(payload, out);
+    record(MessageType::DepthSnapshot, timer.nsecsElapsed(), ok);
+    return ok;
+}
+
+bool FeedDecoder::decodeKlines(const ExchangeAdapter& adapter, const QByteArray& payload, std::vector<Kline>& out) {
+    QElapsedTimer timer;
+    timer.start();
+    bool ok = adapter.decodeKlines(payload, out);
+    record(MessageType::Klines, timer.nsecsElapsed(), ok);
+    return ok;
+}
+
+bool FeedDecoder::decodeTicker(const ExchangeAdapter& adapter, const QByteArray& payload, Ticker24h& out) {
+    QElapsedTimer timer;
+    timer.start();
+    bool ok = adapter.decodeTicker(payload, out);
+    record(MessageType::Ticker24h, timer.nsecsElapsed(), ok);
+    return ok;
+}
+
+StreamMessage FeedDecoder::decodeStream(const ExchangeAdapter& adapter, const QByteArray& payload) {
+    QElapsedTimer timer;
+    timer.start();
+
+    StreamMessage msg;
+    bool ok = adapter.decodeStream(payload, msg);
+
+    MessageType statsType = MessageType::StreamDepth;
+    switch (msg.type) {
+    case StreamMessage::Type::Depth:  statsType = MessageType::StreamDepth; break;
+    case StreamMessage::Type::Kline:  statsType = MessageType::StreamKline; break;
+    case StreamMessage::Type::Ticker: statsType = MessageType::StreamTicker; break;
+    case StreamMessage::Type::Trade:  statsType = MessageType::StreamTrade; break;
+    case StreamMessage::Type::None:
+        // Control frames are not market data, keep them out of the stats
+        if (ok) return msg;
+        break;
+    }
+
+    record(statsType, timer.nsecsElapsed(), ok);
+    return msg;
+}
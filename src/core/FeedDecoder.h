@@ -0,0 +1,78 @@
+/**
+ * @file FeedDecoder.h
+ * @brief Worker-pool decode stage turning raw exchange payloads into plain structs.
+ *
+ * Payload parsing never runs on the GUI thread: MarketDataHub hands the raw
+ * bytes to run(), the decode functions below execute on a QThreadPool with
+ * the active ExchangeAdapter, and only finished structs are posted back.
+ * Time spent decoding is accumulated per message type.
+ *
+ * Jobs given to runSerial() share one worker of their own and run one at a
+ * time in submission order, so that lane can act as the single producer of
+ * an SpscRing (the trade tape).
+ */
+
+#ifndef FEEDDECODER_H
+#define FEEDDECODER_H
+
+#include <QByteArray>
+#include <QThreadPool>
+#include <array>
+#include <atomic>
+#include <functional>
+#include "ExchangeAdapter.h"
+
+/**
+ * @struct DecodeStats
+ * @brief Decode cost counters for one message type.
+ */
+struct DecodeStats {
+    quint64 messages = 0;
+    quint64 failures = 0;
+    quint64 totalNs = 0;
+    quint64 maxNs = 0;
+
+    double avgUs() const { return messages ? totalNs / 1000.0 / messages : 0.0; }
+};
+
+/**
+ * @class FeedDecoder
+ * @brief Thread pool plus the thread-safe payload decoders it runs.
+ */
+class FeedDecoder {
+public:
+    enum class MessageType { DepthSnapshot, Klines, Ticker24h, StreamDepth, StreamKline, StreamTicker, StreamTrade, Count };
+
+    FeedDecoder();
+    ~FeedDecoder();
+
+    /// Queues a decode job on the worker pool.
+    void run(std::function<void()> job);
+
+    /// Queues a job on the serial lane: in order, never two at once.
+    void runSerial(std::function<void()> job);
+
+    DecodeStats stats(MessageType type) const;
+
+    // Timed wrappers around the adapter's decoders, safe to call from any thread
+    bool decodeDepth(const ExchangeAdapter& adapter, const QByteArray& payload, DepthSnapshot& out);
+    bool decodeKlines(const ExchangeAdapter& adapter, const QByteArray& payload, std::vector<Kline>& out);
+    bool decodeTicker(const ExchangeAdapter& adapter, const QByteArray& payload, Ticker24h& out);
+    StreamMessage decodeStream(const ExchangeAdapter& adapter, const QByteArray& payload);
+
+private:
+    struct Counters {
+        std::atomic<quint64> messages{0};
+        std::atomic<quint64> failures{0};
+        std::atomic<quint64> totalNs{0};
+        std::atomic<quint64> maxNs{0};
+    };
+
+    void record(MessageType type, quint64 elapsedNs, bool ok);
+
+    QThreadPool m_pool;
+    QThreadPool m_serialPool;
+    std::array<Counters, static_cast<size_t>(MessageType::Count)> m_counters;
+};
+
+#endif // FEEDDECODER_H
@@ -0,0 +1,164 @@
+#include "FeedLog.h"
+#include <QDebug>
+#include <QtEndian>
+#include <algorithm>
+#include <cstring>
+
+// ==========================================
+// FeedRecorder
+// ==========================================
+
+FeedRecorder::~FeedRecorder() {
+    close();
+}
+
+bool FeedRecorder::open(const QString& path) {
+    close();
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qDebug() << "Cannot open feed log for writing:" << path << m_file.errorString();
+        return false;
+    }
+
+    char header[HEADER_SIZE];
+    std::memcpy(header, MAGIC, sizeof(MAGIC));
+    qToLittleEndian<quint32>(VERSION, header + sizeof(MAGIC));
+    m_file.write(header, HEADER_SIZE);
+
+    m_records = 0;
+    m_bytes = HEADER_SIZE;
+    m_clock.start();
+    return true;
+}
+
+void FeedRecorder::close() {
+    if (!m_file.isOpen()) return;
+    m_file.flush();
+    m_file.close();
+}
+
+void FeedRecorder::append(FeedRecord::Source source, quint8 kind, const QByteArray& symbol,
+                          const QByteArray& detail, const QByteArray& payload) {
+    if (!m_file.isOpen()) return;
+
+    const QByteArray sym = symbol.left(255);
+    const QByteArray det = detail.left(255);
+
+    char header[RECORD_HEADER_SIZE];
+    qToLittleEndian<quint64>(static_cast<quint64>(m_clock.nsecsElapsed()), header);
+    qToLittleEndian<quint32>(static_cast<quint32>(payload.size()), header + 8);
+    header[12] = static_cast<char>(source);
+    header[13] = static_cast<char>(kind);
+    header[14] = static_cast<char>(sym.size());
+    header[15] = static_cast<char>(det.size());
+
+    m_file.write(header, RECORD_HEADER_SIZE);
+    m_file.write(sym);
+    m_file.write(det);
+    m_file.write(payload);
+
+    m_records++;
+    m_bytes += RECORD_HEADER_SIZE + sym.size() + det.size() + payload.size();
+}
+
+// ==========================================
+// FeedReplayer
+// ==========================================
+
+FeedReplayer::FeedReplayer(QObject* parent)
+    : QObject(parent)
+{
+    m_timer = new QTimer(this);
+    m_timer->setSingleShot(true);
+    m_timer->setTimerType(Qt::PreciseTimer);
+    connect(m_timer, &QTimer::timeout, this, &FeedReplayer::pump);
+}
+
+bool FeedReplayer::open(const QString& path) {
+    m_file.close();
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        qDebug() << "Cannot open feed log:" << path << m_file.errorString();
+        return false;
+    }
+
+    char header[FeedRecorder::HEADER_SIZE];
+    if (m_file.read(header, sizeof(header)) != sizeof(header)
+        || std::memcmp(header, FeedRecorder::MAGIC, sizeof(FeedRecorder::MAGIC)) != 0
+        || qFromLittleEndian<quint32>(header + sizeof(FeedRecorder::MAGIC)) != FeedRecorder::VERSION) {
+        qDebug() << "Not a feed log (or unsupported version):" << path;
+        m_file.close();
+        return false;
+    }
+
+    m_hasNext = readNext(m_next);
+    m_firstNs = m_hasNext ? m_next.monoNs : 0;
+    return true;
+}
+
+void FeedReplayer::start(double speed) {
+    m_speed = std::max(0.0, speed);
+    m_records = 0;
+    m_bytes = 0;
+    m_clock.start();
+    m_timer->start(0);
+}
+
+void FeedReplayer::stop() {
+    m_timer->stop();
+}
+
+bool FeedReplayer::readNext(FeedRecord& record) {
+    char header[FeedRecorder::RECORD_HEADER_SIZE];
+    if (m_file.read(header, sizeof(header)) != sizeof(header)) return false;
+
+    record.monoNs = qFromLittleEndian<quint64>(header);
+    const quint32 payloadSize = qFromLittleEndian<quint32>(header + 8);
+    record.source = static_cast<FeedRecord::Source>(static_cast<quint8>(header[12]));
+    record.kind = static_cast<quint8>(header[13]);
+    const int symbolSize = static_cast<quint8>(header[14]);
+    const int detailSize = static_cast<quint8>(header[15]);
+
+    record.symbol = m_file.read(symbolSize);
+    record.detail = m_file.read(detailSize);
+    record.payload = m_file.read(payloadSize);
+
+    // A truncated tail (recording killed mid-write) ends the replay
+    return record.symbol.size() == symbolSize && record.detail.size() == detailSize
+        && record.payload.size() == static_cast<qsizetype>(payloadSize);
+}
+
+void FeedReplayer::pump() {
+    int batch = 0;
+    while (m_hasNext) {
+        if (m_speed > 0) {
+            const qint64 dueNs = static_cast<qint64>((m_next.monoNs - m_firstNs) / m_speed);
+            if (dueNs > m_clock.nsecsElapsed()) break;
+        } else if (batch >= MAX_SPEED_BATCH) {
+            break;
+        }
+
+        emit recordReady(m_next);
+        m_records++;
+        m_bytes += m_next.payload.size();
+        batch++;
+        m_hasNext = readNext(m_next);
+    }
+
+    if (!m_hasNext) {
+        m_file.close();
+        emit finished(m_records, m_bytes, m_clock.elapsed());
+        return;
+    }
+    scheduleNext();
+}
+
+void FeedReplayer::scheduleNext() {
+    if (m_speed <= 0) {
+        m_timer->start(0);
+        return;
+    }
+    const qint64 dueNs = static_cast<qint64>((m_next.monoNs - m_firstNs) / m_speed);
+    const qint64 waitMs = std::max<qint64>(0, (dueNs - m_clock.nsecsElapsed()) / 1000000);
+    m_timer->start(static_cast<int>(std::min<qint64>(waitMs, 60000)));
+}
@@ -0,0 +1,117 @@
+/**
+ * @file FeedLog.h
+ * @brief Append-only binary log of raw market data payloads, and its replayer.
+ *
+ * File layout (little-endian):
+ * - Header: 8-byte magic "MDFEED\0\0", uint32 format version
+ * - Records, back to back:
+ *     uint64 monotonic timestamp (ns since recording started)
+ *     uint32 payload size
+ *     uint8  source (FeedRecord::Source)
+ *     uint8  kind   (REST reply kind, 0 for stream frames)
+ *     uint8  symbol size, uint8 detail size
+ *     symbol bytes, detail bytes, payload bytes
+ *
+ * Payloads are stored exactly as received, so a replay exercises the same
+ * decode path as live traffic and can be timed deterministically offline.
+ */
+
+#ifndef FEEDLOG_H
+#define FEEDLOG_H
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+
+/**
+ * @struct FeedRecord
+ * @brief One raw inbound payload with its routing metadata.
+ */
+struct FeedRecord {
+    enum class Source : quint8 { Rest = 0, Stream = 1 };
+
+    quint64 monoNs = 0;
+    Source source = Source::Stream;
+    quint8 kind = 0;
+    QByteArray symbol;      // Application symbol for REST, exchange pair for streams
+    QByteArray detail;      // REST: kline interval ("1h@endTime" for history pages), streams: stream name
+    QByteArray payload;
+};
+
+/**
+ * @class FeedRecorder
+ * @brief Buffered writer of FeedRecords. Not thread-safe: call from one thread.
+ */
+class FeedRecorder {
+public:
+    static constexpr char MAGIC[8] = {'M', 'D', 'F', 'E', 'E', 'D', '\0', '\0'};
+    static constexpr quint32 VERSION = 1;
+    static constexpr int HEADER_SIZE = 12;
+    static constexpr int RECORD_HEADER_SIZE = 16;
+
+    ~FeedRecorder();
+
+    bool open(const QString& path);
+    void close();
+    bool isOpen() const { return m_file.isOpen(); }
+
+    void append(FeedRecord::Source source, quint8 kind, const QByteArray& symbol,
+                const QByteArray& detail, const QByteArray& payload);
+
+    quint64 recordCount() const { return m_records; }
+    quint64 bytesWritten() const { return m_bytes; }
+
+private:
+    QFile m_file;
+    QElapsedTimer m_clock;
+    quint64 m_records = 0;
+    quint64 m_bytes = 0;
+};
+
+/**
+ * @class FeedReplayer
+ * @brief Streams a recorded log back, paced by the recorded timestamps.
+ *
+ * A speed of 1 reproduces the original pacing, N plays N times faster and
+ * 0 plays as fast as possible (in batches, so the event loop stays live).
+ */
+class FeedReplayer : public QObject {
+    Q_OBJECT
+
+public:
+    static constexpr int MAX_SPEED_BATCH = 256;
+
+    explicit FeedReplayer(QObject* parent = nullptr);
+
+    bool open(const QString& path);
+    void start(double speed);
+    void stop();
+    bool isRunning() const { return m_timer->isActive(); }
+
+signals:
+    void recordReady(const FeedRecord& record);
+    void finished(quint64 records, quint64 bytes, qint64 elapsedMs);
+
+private slots:
+    void pump();
+
+private:
+    bool readNext(FeedRecord& record);
+    void scheduleNext();
+
+    QFile m_file;
+    QTimer* m_timer;
+    QElapsedTimer m_clock;
+    double m_speed = 1.0;
+
+    FeedRecord m_next;
+    bool m_hasNext = false;
+    quint64 m_firstNs = 0;
+    quint64 m_records = 0;
+    quint64 m_bytes = 0;
+};
+
+#endif // FEEDLOG_H
@@ -0,0 +1,151 @@
+/**
+ * @file FixedPoint.h
+ * @brief Exact decimal Price and Qty value types.
+ *
+ * Exchange prices and sizes are decimal strings with at most 8 fractional
+ * digits, so they are stored as int64 counts of 1e-8 units. Book keys,
+ * comparisons and tick/step rounding are then exact integer operations:
+ * no rounding drift in aggregation buckets, and levels can be hashed.
+ * Convert to double only for display or for products (notional, ratios).
+ */
+
+#ifndef FIXEDPOINT_H
+#define FIXEDPOINT_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+
+/**
+ * @class FixedDecimal
+ * @brief Signed decimal with 8 fractional digits. @p Tag keeps prices and
+ *        quantities from being mixed up by accident.
+ */
+template <typename Tag>
+class FixedDecimal {
+public:
+    static constexpr int DECIMALS = 8;
+    static constexpr int64_t SCALE = 100000000;
+
+    constexpr FixedDecimal() = default;
+
+    static constexpr FixedDecimal fromRaw(int64_t raw) {
+        FixedDecimal v;
+        v.m_raw = raw;
+        return v;
+    }
+
+    static FixedDecimal fromDouble(double value) {
+        return fromRaw(std::llround(value * SCALE));
+    }
+
+    /**
+     * Parses a plain decimal string ("64012.35000000", "-0.5", "12").
+     * Digits beyond the 8th decimal are truncated.
+     * @return false on empty input or any other character.
+     */
+    static bool parse(std::string_view text, FixedDecimal& out) {
+        size_t i = 0;
+        bool negative = false;
+        if (i < text.size() && (text[i] == '-' || text[i] == '+')) {
+            negative = text[i] == '-';
+            ++i;
+        }
+
+        int64_t units = 0;
+        int digits = 0;
+        for (; i < text.size() && text[i] != '.'; ++i, ++digits) {
+            char c = text[i];
+            if (c < '0' || c > '9') return false;
+            units = units * 10 + (c - '0');
+        }
+
+        int64_t fraction = 0;
+        int fractionDigits = 0;
+        if (i < text.size()) {
+            for (++i; i < text.size(); ++i, ++digits) {
+                char c = text[i];
+                if (c < '0' || c > '9') return false;
+                if (fractionDigits < DECIMALS) {
+                    fraction = fraction * 10 + (c - '0');
+                    ++fractionDigits;
+                }
+            }
+        }
+        if (digits == 0) return false;
+
+        for (; fractionDigits < DECIMALS; ++fractionDigits) fraction *= 10;
+        int64_t raw = units * SCALE + fraction;
+        out.m_raw = negative ? -raw : raw;
+        return true;
+    }
+
+    constexpr int64_t raw() const { return m_raw; }
+    double toDouble() const { return static_cast<double>(m_raw) / SCALE; }
+    constexpr bool isZero() const { return m_raw == 0; }
+    constexpr bool isPositive() const { return m_raw > 0; }
+
+    /// Largest multiple of @p step not above this value.
+    constexpr FixedDecimal floorTo(FixedDecimal step) const {
+        if (step.m_raw <= 0) return *this;
+        int64_t q = m_raw / step.m_raw;
+        if (m_raw % step.m_raw != 0 && m_raw < 0) --q;
+        return fromRaw(q * step.m_raw);
+    }
+
+    /// Smallest multiple of @p step not below this value.
+    constexpr FixedDecimal ceilTo(FixedDecimal step) const {
+        FixedDecimal down = floorTo(step);
+        return down.m_raw == m_raw ? down : fromRaw(down.m_raw + step.m_raw);
+    }
+
+    /// Nearest multiple of @p step, halves rounded up.
+    constexpr FixedDecimal roundTo(FixedDecimal step) const {
+        if (step.m_raw <= 0) return *this;
+        return fromRaw(m_raw + step.m_raw / 2).floorTo(step);
+    }
+
+    /// Fractional digits needed to print this value exactly (0.01 -> 2).
+    constexpr int decimals() const {
+        if (m_raw == 0) return 0;
+        int64_t r = m_raw < 0 ? -m_raw : m_raw;
+        int d = DECIMALS;
+        while (d > 0 && r % 10 == 0) {
+            r /= 10;
+            --d;
+        }
+        return d;
+    }
+
+    constexpr FixedDecimal operator+(FixedDecimal o) const { return fromRaw(m_raw + o.m_raw); }
+    constexpr FixedDecimal operator-(FixedDecimal o) const { return fromRaw(m_raw - o.m_raw); }
+    FixedDecimal& operator+=(FixedDecimal o) { m_raw += o.m_raw; return *this; }
+    FixedDecimal& operator-=(FixedDecimal o) { m_raw -= o.m_raw; return *this; }
+
+    friend constexpr bool operator==(FixedDecimal a, FixedDecimal b) { return a.m_raw == b.m_raw; }
+    friend constexpr bool operator!=(FixedDecimal a, FixedDecimal b) { return a.m_raw != b.m_raw; }
+    friend constexpr bool operator<(FixedDecimal a, FixedDecimal b) { return a.m_raw < b.m_raw; }
+    friend constexpr bool operator>(FixedDecimal a, FixedDecimal b) { return a.m_raw > b.m_raw; }
+    friend constexpr bool operator<=(FixedDecimal a, FixedDecimal b) { return a.m_raw <= b.m_raw; }
+    friend constexpr bool operator>=(FixedDecimal a, FixedDecimal b) { return a.m_raw >= b.m_raw; }
+
+private:
+    int64_t m_raw = 0;
+};
+
+struct PriceTag {};
+struct QtyTag {};
+
+using Price = FixedDecimal<PriceTag>;
+using Qty = FixedDecimal<QtyTag>;
+
+namespace std {
+template <typename Tag>
+struct hash<FixedDecimal<Tag>> {
+    size_t operator()(FixedDecimal<Tag> v) const noexcept { return std::hash<int64_t>()(v.raw()); }
+};
+} // namespace std
+
+#endif // FIXEDPOINT_H
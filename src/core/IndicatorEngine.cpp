@@ -0,0 +1,97 @@
+#include "IndicatorEngine.h"
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+constexpr double NONE = std::numeric_limits<double>::quiet_NaN();
+
+} // namespace
+
+IndicatorEngine::IndicatorEngine(int smaPeriod, int rsiPeriod)
+    : m_smaPeriod(std::max(1, smaPeriod)), m_rsiPeriod(std::max(1, rsiPeriod)) {}
+
+void IndicatorEngine::reset(const CandleBuffer& candles) {
+    m_smaSum = 0;
+    m_avgGain = m_avgLoss = 0;
+    m_seedGain = m_seedLoss = 0;
+    m_sma.clear();
+    m_rsi.clear();
+    m_sma.reserve(candles.size());
+    m_rsi.reserve(candles.size());
+
+    for (size_t i = 0; i < candles.size(); ++i) {
+        if (i > 0) commit(candles, i - 1);
+        m_sma.push_back(smaAt(candles, i));
+        m_rsi.push_back(rsiAt(candles, i));
+    }
+}
+
+IndicatorEngine::Change IndicatorEngine::update(const CandleBuffer& candles, size_t index) {
+    const size_t last = candles.size() - 1;
+    if (!candles.empty() && index == last) {
+        if (m_sma.size() == candles.size()) {
+            m_sma[last] = smaAt(candles, last);
+            m_rsi[last] = rsiAt(candles, last);
+            return Change::Revised;
+        }
+        if (m_sma.size() == last) {
+            // The previous live candle is final now
+            if (last > 0) commit(candles, last - 1);
+            m_sma.push_back(smaAt(candles, last));
+            m_rsi.push_back(rsiAt(candles, last));
+            return Change::Appended;
+        }
+    }
+    reset(candles);
+    return Change::Rebuilt;
+}
+
+void IndicatorEngine::commit(const CandleBuffer& candles, size_t index) {
+    const std::vector<double>& close = candles.closes();
+    const size_t window = static_cast<size_t>(m_smaPeriod - 1);
+
+    // Window of the next candle: gains this close, loses the one period - 1 back
+    m_smaSum += close[index];
+    if (index >= window) m_smaSum -= close[index - window];
+
+    if (index == 0) return;
+    if (index < static_cast<size_t>(m_rsiPeriod)) {
+        const double change = close[index] - close[index - 1];
+        if (change > 0) m_seedGain += change;
+        else m_seedLoss -= change;
+        return;
+    }
+    averagesAt(candles, index, m_avgGain, m_avgLoss);
+}
+
+double IndicatorEngine::smaAt(const CandleBuffer& candles, size_t index) const {
+    if (index + 1 < static_cast<size_t>(m_smaPeriod)) return NONE;
+    return (m_smaSum + candles.closes()[index]) / m_smaPeriod;
+}
+
+double IndicatorEngine::rsiAt(const CandleBuffer& candles, size_t index) const {
+    double gain = 0, loss = 0;
+    if (!averagesAt(candles, index, gain, loss)) return NONE;
+    // RSI = 100 - 100 / (1 + average gain / average loss)
+    return loss == 0 ? 100.0 : 100.0 - 100.0 / (1.0 + gain / loss);
+}
+
+bool IndicatorEngine::averagesAt(const CandleBuffer& candles, size_t index, double& gain, double& loss) const {
+    const size_t period = static_cast<size_t>(m_rsiPeriod);
+    if (index < period) return false;
+
+    const std::vector<double>& close = candles.closes();
+    const double change = close[index] - close[index - 1];
+    const double up = change > 0 ? change : 0;
+    const double down = change < 0 ? -change : 0;
+    if (index == period) {
+        // Seed: simple average of the first period changes
+        gain = (m_seedGain + up) / m_rsiPeriod;
+        loss = (m_seedLoss + down) / m_rsiPeriod;
+    } else {
+        gain = (m_avgGain * (m_rsiPeriod - 1) + up) / m_rsiPeriod;
+        loss = (m_avgLoss * (m_rsiPeriod - 1) + down) / m_rsiPeriod;
+    }
+    return true;
+}
@@ -0,0 +1,74 @@
+/**
+ * @file IndicatorEngine.h
+ * @brief Streaming SMA and RSI over a CandleBuffer.
+ *
+ * Each indicator keeps rolling state for the closed candles (all but the
+ * last one) and derives the live candle's value from that state and the
+ * live close:
+ * - SMA: sum of the period - 1 closes before the live candle
+ * - RSI (Wilder): smoothed average gain / loss up to the previous close
+ *
+ * Revising the live candle or appending a new one is O(1) and touches only
+ * the last value of each output column. Anything else (history reload,
+ * older pages prepended, a backfill rewriting an older candle) is an O(n)
+ * reset. GUI-free.
+ */
+
+#ifndef INDICATORENGINE_H
+#define INDICATORENGINE_H
+
+#include "CandleBuffer.h"
+#include <cstddef>
+#include <vector>
+
+/**
+ * @class IndicatorEngine
+ * @brief Incremental indicator columns aligned with the candles, NaN where undefined.
+ */
+class IndicatorEngine {
+public:
+    static constexpr int DEFAULT_SMA_PERIOD = 20;
+    static constexpr int DEFAULT_RSI_PERIOD = 14;
+
+    /// What update() did to the output columns.
+    enum class Change {
+        Revised,    // Last value recomputed
+        Appended,   // One value added
+        Rebuilt     // Every value recomputed
+    };
+
+    explicit IndicatorEngine(int smaPeriod = DEFAULT_SMA_PERIOD, int rsiPeriod = DEFAULT_RSI_PERIOD);
+
+    int smaPeriod() const { return m_smaPeriod; }
+    int rsiPeriod() const { return m_rsiPeriod; }
+
+    /// Recomputes everything from @p candles.
+    void reset(const CandleBuffer& candles);
+
+    /// Follows a change of candle @p index; O(1) when it is the live or a new last candle.
+    Change update(const CandleBuffer& candles, size_t index);
+
+    const std::vector<double>& sma() const { return m_sma; }
+    const std::vector<double>& rsi() const { return m_rsi; }
+
+private:
+    void commit(const CandleBuffer& candles, size_t index);
+    double smaAt(const CandleBuffer& candles, size_t index) const;
+    double rsiAt(const CandleBuffer& candles, size_t index) const;
+    bool averagesAt(const CandleBuffer& candles, size_t index, double& gain, double& loss) const;
+
+    int m_smaPeriod;
+    int m_rsiPeriod;
+
+    // Rolling state over the closed candles [0, m_sma.size() - 1)
+    double m_smaSum = 0;        // Closes of the period - 1 candles before the live one
+    double m_avgGain = 0;       // Wilder averages, once period changes are seen
+    double m_avgLoss = 0;
+    double m_seedGain = 0;      // Sums of the first changes, until then
+    double m_seedLoss = 0;
+
+    std::vector<double> m_sma;
+    std::vector<double> m_rsi;
+};
+
+#endif // INDICATORENGINE_H
@@ -0,0 +1,39 @@
+#include "KlineCache.h"
+
+QString KlineCache::key(const QString& symbol, const QString& interval, qint64 endTime) {
+    return symbol + ':' + interval + ':' + QString::number(endTime);
+}
+
+const std::vector<Kline>* KlineCache::find(const QString& key) {
+    auto it = m_index.find(key);
+    if (it == m_index.end()) {
+        m_misses++;
+        return nullptr;
+    }
+    m_hits++;
+    m_entries.splice(m_entries.begin(), m_entries, it.value());
+    return &m_entries.front().klines;
+}
+
+void KlineCache::insert(const QString& key, std::vector<Kline> klines) {
+    if (m_capacity == 0) return;
+
+    auto it = m_index.find(key);
+    if (it != m_index.end()) {
+        it.value()->klines = std::move(klines);
+        m_entries.splice(m_entries.begin(), m_entries, it.value());
+        return;
+    }
+
+    if (m_entries.size() >= m_capacity) {
+        m_index.remove(m_entries.back().key);
+        m_entries.pop_back();
+    }
+    m_entries.push_front(Entry{key, std::move(klines)});
+    m_index.insert(key, m_entries.begin());
+}
+
+void KlineCache::clear() {
+    m_entries.clear();
+    m_index.clear();
+}
@@ -0,0 +1,59 @@
+/**
+ * @file KlineCache.h
+ * @brief Bounded LRU cache of closed kline pages.
+ *
+ * Chart history is paged backwards with endTime requests; each page is
+ * keyed by symbol / interval / page end. Closed candles never change, so a
+ * cached page is served as is: scrolling back over history already seen,
+ * or switching back to a pair / interval, costs no request and no decode.
+ *
+ * Hub thread only.
+ */
+
+#ifndef KLINECACHE_H
+#define KLINECACHE_H
+
+#include <QHash>
+#include <QString>
+#include <list>
+#include <vector>
+#include "MarketEvents.h"
+
+/**
+ * @class KlineCache
+ * @brief Least-recently-used map of page key -> klines, bounded in pages.
+ */
+class KlineCache {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 256;    // Pages: 256k candles at 1000 per page
+
+    explicit KlineCache(size_t capacity = DEFAULT_CAPACITY) : m_capacity(capacity) {}
+
+    static QString key(const QString& symbol, const QString& interval, qint64 endTime);
+
+    /// Cached page, now most recently used; nullptr on a miss.
+    const std::vector<Kline>* find(const QString& key);
+
+    /// Stores @p klines under @p key, evicting the least recently used page when full.
+    void insert(const QString& key, std::vector<Kline> klines);
+
+    void clear();
+    size_t size() const { return m_entries.size(); }
+    size_t capacity() const { return m_capacity; }
+    quint64 hits() const { return m_hits; }
+    quint64 misses() const { return m_misses; }
+
+private:
+    struct Entry {
+        QString key;
+        std::vector<Kline> klines;
+    };
+
+    size_t m_capacity;
+    std::list<Entry> m_entries;     // Most recently used first
+    QHash<QString, std::list<Entry>::iterator> m_index;
+    quint64 m_hits = 0;
+    quint64 m_misses = 0;
+};
+
+#endif // KLINECACHE_H
@@ -0,0 +1,73 @@
+#include "L2Book.h"
+#include <algorithm>
+
+void L2Book::clear() {
+    m_bids.clear();
+    m_asks.clear();
+}
+
+void L2Book::applySnapshot(const std::vector<BookLevel>& bids, const std::vector<BookLevel>& asks) {
+    auto load = [](std::vector<BookLevel>& side, const std::vector<BookLevel>& levels) {
+        side.clear();
+        side.reserve(levels.size());
+        for (const BookLevel& lvl : levels) {
+            if (lvl.qty.isPositive()) side.push_back(lvl);
+        }
+    };
+    load(m_bids, bids);
+    load(m_asks, asks);
+
+    // Feeds send best first: reversing is usually enough, sort only if needed
+    auto ascending = [](const BookLevel& a, const BookLevel& b) { return a.price < b.price; };
+    auto descending = [](const BookLevel& a, const BookLevel& b) { return a.price > b.price; };
+    if (!std::is_sorted(m_bids.begin(), m_bids.end(), ascending)) {
+        std::reverse(m_bids.begin(), m_bids.end());
+        if (!std::is_sorted(m_bids.begin(), m_bids.end(), ascending)) std::sort(m_bids.begin(), m_bids.end(), ascending);
+    }
+    if (!std::is_sorted(m_asks.begin(), m_asks.end(), descending)) {
+        std::reverse(m_asks.begin(), m_asks.end());
+        if (!std::is_sorted(m_asks.begin(), m_asks.end(), descending)) std::sort(m_asks.begin(), m_asks.end(), descending);
+    }
+}
+
+void L2Book::applyChanges(const std::vector<BookLevel>& bids, const std::vector<BookLevel>& asks) {
+    for (const BookLevel& lvl : bids) setLevel(BookSide::Bid, lvl.price, lvl.qty);
+    for (const BookLevel& lvl : asks) setLevel(BookSide::Ask, lvl.price, lvl.qty);
+}
+
+std::vector<BookLevel>::const_iterator L2Book::find(BookSide side, const std::vector<BookLevel>& v, Price price) {
+    if (side == BookSide::Bid) {
+        return std::lower_bound(v.begin(), v.end(), price,
+                                [](const BookLevel& lvl, Price p) { return lvl.price < p; });
+    }
+    return std::lower_bound(v.begin(), v.end(), price,
+                            [](const BookLevel& lvl, Price p) { return lvl.price > p; });
+}
+
+Qty L2Book::setLevel(BookSide side, Price price, Qty qty) {
+    std::vector<BookLevel>& v = levels(side);
+    auto it = v.begin() + (find(side, v, price) - v.cbegin());
+    const bool found = (it != v.end() && it->price == price);
+    const Qty previous = found ? it->qty : Qty();
+
+    if (!qty.isPositive()) {
+        if (found) v.erase(it);
+    } else if (found) {
+        it->qty = qty;
+    } else {
+        v.insert(it, {price, qty});
+    }
+    return previous;
+}
+
+Qty L2Book::quantityAt(BookSide side, Price price) const {
+    const std::vector<BookLevel>& v = levels(side);
+    auto it = find(side, v, price);
+    return (it != v.end() && it->price == price) ? it->qty : Qty();
+}
+
+void L2Book::top(BookSide side, size_t count, std::vector<BookLevel>& out) const {
+    const std::vector<BookLevel>& v = levels(side);
+    const size_t n = std::min(count, v.size());
+    out.assign(v.rbegin(), v.rbegin() + static_cast<std::ptrdiff_t>(n));
+}
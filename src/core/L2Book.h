@@ -0,0 +1,78 @@
+/**
+ * @file L2Book.h
+ * @brief GUI-free price-level (L2) order book on contiguous sorted arrays.
+ *
+ * Each side is a flat vector sorted from worst to best price, so the best
+ * level is always the last element:
+ * - Best bid / ask and the i-th best level are O(1)
+ * - Level lookup is a binary search, O(log n)
+ * - Insert / delete shift only the levels better than the touched one;
+ *   diff traffic concentrates at the top of book, so that is a few elements
+ *
+ * Compared to std::map there is no per-level allocation and iteration walks
+ * contiguous memory. Quantities of zero delete a level, as in diff-depth feeds.
+ */
+
+#ifndef L2BOOK_H
+#define L2BOOK_H
+
+#include "MarketTypes.h"
+#include <cstddef>
+#include <vector>
+
+enum class BookSide { Bid, Ask };
+
+/**
+ * @class L2Book
+ * @brief Aggregated bid/ask levels of one symbol.
+ */
+class L2Book {
+public:
+    void clear();
+
+    /// Replaces the whole book. Levels may be in any order; zero quantities are skipped.
+    void applySnapshot(const std::vector<BookLevel>& bids, const std::vector<BookLevel>& asks);
+
+    /// Applies level changes in order (zero quantity deletes).
+    void applyChanges(const std::vector<BookLevel>& bids, const std::vector<BookLevel>& asks);
+
+    /// Sets one level. @return the previous quantity, zero if the level was absent.
+    Qty setLevel(BookSide side, Price price, Qty qty);
+
+    Qty quantityAt(BookSide side, Price price) const;
+
+    bool empty(BookSide side) const { return levels(side).empty(); }
+    size_t depth(BookSide side) const { return levels(side).size(); }
+
+    /// @p i-th best level of @p side (0 = best). Requires i < depth(side).
+    const BookLevel& level(BookSide side, size_t i) const {
+        const std::vector<BookLevel>& v = levels(side);
+        return v[v.size() - 1 - i];
+    }
+
+    /// Best level, or nullptr if the side is empty.
+    const BookLevel* best(BookSide side) const {
+        const std::vector<BookLevel>& v = levels(side);
+        return v.empty() ? nullptr : &v.back();
+    }
+    const BookLevel* bestBid() const { return best(BookSide::Bid); }
+    const BookLevel* bestAsk() const { return best(BookSide::Ask); }
+
+    /// Copies the best @p count levels of @p side, best price first.
+    void top(BookSide side, size_t count, std::vector<BookLevel>& out) const;
+
+    /// Contiguous levels of @p side, worst to best (best last), for scans.
+    const std::vector<BookLevel>& sideLevels(BookSide side) const { return levels(side); }
+
+private:
+    std::vector<BookLevel>& levels(BookSide side) { return side == BookSide::Bid ? m_bids : m_asks; }
+    const std::vector<BookLevel>& levels(BookSide side) const { return side == BookSide::Bid ? m_bids : m_asks; }
+
+    /// First position whose price is not worse than @p price.
+    static std::vector<BookLevel>::const_iterator find(BookSide side, const std::vector<BookLevel>& v, Price price);
+
+    std::vector<BookLevel> m_bids;  // Ascending price, best bid last
+    std::vector<BookLevel> m_asks;  // Descending price, best ask last
+};
+
+#endif // L2BOOK_H
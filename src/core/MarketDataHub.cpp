@@ -0,0 +1,847 @@
+#include "MarketDataHub.h"
+#include "BinanceAdapter.h"
+#include "SymbolRegistry.h"
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDebug>
+#include <QMetaObject>
+#include <QNetworkRequest>
+#include <QUrl>
+#include <algorithm>
+#include <utility>
+
+MarketDataHub* MarketDataHub::instance() {
+    static MarketDataHub* hub = new MarketDataHub(QCoreApplication::instance());
+    return hub;
+}
+
+MarketDataHub::MarketDataHub(QObject* parent)
+    : QObject(parent)
+{
+    qRegisterMetaType<BookUpdate>();
+    qRegisterMetaType<BookMetrics>();
+    qRegisterMetaType<Kline>();
+    qRegisterMetaType<KlineBatch>();
+    qRegisterMetaType<Ticker24h>();
+    qRegisterMetaType<Trade>();
+    qRegisterMetaType<TradeBatch>();
+
+    m_adapter = std::make_shared<BinanceAdapter>();
+
+    m_networkManager = new QNetworkAccessManager(this);
+    m_scheduler = new RequestScheduler(m_networkManager, this);
+    connect(m_scheduler, &RequestScheduler::finished, this, &MarketDataHub::onHttpResponse);
+
+    m_socket = new QWebSocket(QString(), QWebSocketProtocol::VersionLatest, this);
+    connect(m_socket, &QWebSocket::connected, this, &MarketDataHub::onStreamConnected);
+    connect(m_socket, &QWebSocket::disconnected, this, &MarketDataHub::onStreamDisconnected);
+    connect(m_socket, &QWebSocket::textMessageReceived, this, &MarketDataHub::onStreamMessage);
+
+    m_reconnectTimer = new QTimer(this);
+    m_reconnectTimer->setSingleShot(true);
+    m_reconnectTimer->setInterval(RECONNECT_DELAY_MS);
+    connect(m_reconnectTimer, &QTimer::timeout, this, &MarketDataHub::openStream);
+
+    // REST polling keeps books and tickers alive while the stream is down
+    m_fallbackTimer = new QTimer(this);
+    m_fallbackTimer->setInterval(FALLBACK_POLL_MS);
+    connect(m_fallbackTimer, &QTimer::timeout, this, &MarketDataHub::pollFallback);
+    m_fallbackTimer->start();
+
+    m_localStreamTimer = new QTimer(this);
+    connect(m_localStreamTimer, &QTimer::timeout, this, &MarketDataHub::pollLocalStreams);
+
+    // Runs while a trade stream is subscribed
+    m_tapeTimer = new QTimer(this);
+    m_tapeTimer->setInterval(TRADE_TAPE_DRAIN_MS);
+    connect(m_tapeTimer, &QTimer::timeout, this, &MarketDataHub::drainTradeTape);
+
+    // Books are applied off the GUI thread, each symbol always on the same shard
+    const int shards = std::clamp(QThread::idealThreadCount() / 2, 1, MAX_BOOK_SHARDS);
+    for (int i = 0; i < shards; ++i) {
+        QThread* thread = new QThread(this);
+        thread->setObjectName(QString("BookShard-%1").arg(i));
+        BookShard* shard = new BookShard(i);
+        shard->moveToThread(thread);
+        connect(thread, &QThread::finished, shard, &QObject::deleteLater);
+        connect(shard, &BookShard::bookUpdated, this, &MarketDataHub::bookUpdated);
+        connect(shard, &BookShard::bookMetricsUpdated, this, &MarketDataHub::onBookMetrics);
+        connect(shard, &BookShard::bookSynced, this, &MarketDataHub::onBookSynced);
+        connect(shard, &BookShard::snapshotNeeded, this, &MarketDataHub::onSnapshotNeeded);
+        thread->start();
+        m_shards.append(shard);
+        m_shardThreads.append(thread);
+    }
+
+    openStream();
+}
+
+MarketDataHub::~MarketDataHub() {
+    for (QThread* thread : m_shardThreads) {
+        thread->quit();
+        thread->wait();
+    }
+}
+
+// ==========================================
+// Subscriptions
+// ==========================================
+
+QString MarketDataHub::streamName(const StreamKey& key) const {
+    return m_adapter->streamName(key.stream, key.symbol, key.interval);
+}
+
+QStringList MarketDataHub::streamNames() const {
+    QStringList names;
+    for (auto it = m_streamRefs.cbegin(); it != m_streamRefs.cend(); ++it) names.append(streamName(it.key()));
+    return names;
+}
+
+void MarketDataHub::subscribe(Stream stream, const QString& symbol, const QString& interval) {
+    acquire({stream, symbol, stream == Stream::Kline ? interval : QString()}, true);
+}
+
+void MarketDataHub::unsubscribe(Stream stream, const QString& symbol, const QString& interval) {
+    release({stream, symbol, stream == Stream::Kline ? interval : QString()}, true);
+}
+
+void MarketDataHub::setLiveBooks(const QStringList& symbols) {
+    const QSet<QString> wanted(symbols.cbegin(), symbols.cend());
+    for (const QString& symbol : QSet<QString>(m_liveBooks).subtract(wanted)) {
+        release({Stream::Depth, symbol, QString()}, false);
+    }
+    for (const QString& symbol : wanted) {
+        if (!m_liveBooks.contains(symbol)) acquire({Stream::Depth, symbol, QString()}, false);
+    }
+    m_liveBooks = wanted;
+}
+
+void MarketDataHub::acquire(const StreamKey& key, bool viewer) {
+    const bool firstReference = (m_streamRefs[key]++ == 0);
+    m_symbolRefs[key.symbol]++;
+    requestSymbolInfo(key.symbol);
+
+    if (key.stream == Stream::Depth) {
+        retainBook(key.symbol, viewer);
+    } else if (key.stream == Stream::Ticker24h) {
+        m_tickerRefs[key.symbol]++;
+        requestTicker(key.symbol);
+    } else if (key.stream == Stream::Trade && firstReference) {
+        refreshTradeStreams();
+    }
+
+    if (!firstReference || !isStreamConnected() || m_replaying) return;
+
+    sendStreamRequest(true, {streamName(key)});
+    if (key.stream == Stream::Depth) requestDepthSnapshot(key.symbol);
+}
+
+void MarketDataHub::release(const StreamKey& key, bool viewer) {
+    auto it = m_streamRefs.find(key);
+    if (it == m_streamRefs.end()) return;
+
+    if (key.stream == Stream::Depth) {
+        releaseBook(key.symbol, viewer);
+    } else if (key.stream == Stream::Ticker24h && --m_tickerRefs[key.symbol] <= 0) {
+        m_tickerRefs.remove(key.symbol);
+    }
+
+    if (--m_symbolRefs[key.symbol] <= 0) {
+        // Nobody shows this symbol any more: its pending replies are stale
+        m_symbolRefs.remove(key.symbol);
+        m_scheduler->invalidate(key.symbol);
+        // An aborted exchangeInfo request is retried on the next subscription
+        m_symbolInfoRequested.remove(key.symbol);
+    }
+
+    if (--it.value() > 0) return;
+    m_streamRefs.erase(it);
+
+    if (key.stream == Stream::Trade) refreshTradeStreams();
+    if (isStreamConnected() && !m_replaying) sendStreamRequest(false, {streamName(key)});
+}
+
+BookShard* MarketDataHub::shardFor(const QString& symbol) const {
+    return m_shards[static_cast<int>(qHash(symbol) % static_cast<size_t>(m_shards.size()))];
+}
+
+void MarketDataHub::retainBook(const QString& symbol, bool viewer) {
+    auto it = m_depth.find(symbol);
+    if (it == m_depth.end()) {
+        DepthState state;
+        state.shard = shardFor(symbol);
+        it = m_depth.insert(symbol, state);
+        BookShard* shard = state.shard;
+        shard->post([shard, symbol]() { shard->resetBook(symbol); });
+    }
+    DepthState& state = it.value();
+    if (!viewer) {
+        state.live = true;
+        return;
+    }
+
+    // A synced book (live, or already on screen) is published right away, once per
+    // viewer: a late viewer has no copy to apply the changes to
+    state.viewers++;
+    BookShard* shard = state.shard;
+    shard->post([shard, symbol]() { shard->setDisplayed(symbol, true); });
+    // Otherwise show something immediately, the stream takes over once synced
+    if (!state.synced) requestDepthPoll(symbol);
+}
+
+void MarketDataHub::releaseBook(const QString& symbol, bool viewer) {
+    auto it = m_depth.find(symbol);
+    if (it == m_depth.end()) return;
+    DepthState& state = it.value();
+    BookShard* shard = state.shard;
+
+    if (!viewer) {
+        state.live = false;
+    } else if (--state.viewers == 0) {
+        shard->post([shard, symbol]() { shard->setDisplayed(symbol, false); });
+    }
+    if (state.viewers > 0 || state.live) return;
+
+    shard->post([shard, symbol]() { shard->removeBook(symbol); });
+    m_depth.erase(it);
+}
+
+void MarketDataHub::resetBooks() {
+    for (auto it = m_depth.begin(); it != m_depth.end(); ++it) {
+        const QString symbol = it.key();
+        BookShard* shard = it->shard;
+        it->synced = false;
+        shard->post([shard, symbol]() { shard->resetBook(symbol); });
+    }
+}
+
+void MarketDataHub::onBookSynced(const QString& symbol) {
+    auto it = m_depth.find(symbol);
+    if (it != m_depth.end()) it->synced = true;
+}
+
+void MarketDataHub::onBookMetrics(const BookMetrics& metrics) {
+    auto it = m_depth.find(metrics.symbol);
+    if (it != m_depth.end()) it->integrity = metrics.integrity;
+    emit bookMetricsUpdated(metrics);
+}
+
+void MarketDataHub::onSnapshotNeeded(const QString& symbol) {
+    auto it = m_depth.find(symbol);
+    if (it == m_depth.end()) return;
+    it->synced = false;
+    requestDepthSnapshot(symbol);
+}
+
+void MarketDataHub::sendStreamRequest(bool subscribe, const QStringList& streams) {
+    // In-process adapters are polled with the current subscription list
+    if (isLocalTransport()) return;
+    const QByteArray request = m_adapter->streamControl(subscribe, streams, m_nextStreamRequestId++);
+    m_socket->sendTextMessage(QString::fromUtf8(request));
+}
+
+// ==========================================
+// Stream connection
+// ==========================================
+
+bool MarketDataHub::isStreamConnected() const {
+    // A replay stands in for a connected stream
+    return m_replaying || m_localStreamTimer->isActive() || m_socket->state() == QAbstractSocket::ConnectedState;
+}
+
+void MarketDataHub::setStreamingEnabled(bool enabled) {
+    if (m_streamingEnabled == enabled || m_replaying) return;
+    m_streamingEnabled = enabled;
+
+    if (enabled) {
+        openStream();
+    } else {
+        m_reconnectTimer->stop();
+        closeStream();
+        resetBooks();
+        m_fallbackTimer->start();
+        emit streamConnectionChanged(false);
+    }
+}
+
+void MarketDataHub::setAdapter(std::shared_ptr<ExchangeAdapter> adapter) {
+    if (!adapter || m_replaying) return;
+
+    // Everything in flight was asked of the previous venue
+    for (auto it = m_symbolRefs.cbegin(); it != m_symbolRefs.cend(); ++it) m_scheduler->invalidate(it.key());
+    m_symbolInfoRequested.clear();
+    m_klineCache.clear();
+    resetBooks();
+    for (DepthState& state : m_depth) state.snapshotInFlight = false;
+
+    qDebug() << "Switching exchange adapter:" << m_adapter->name() << "->" << adapter->name();
+    m_adapter = std::move(adapter);
+    refreshTradeStreams();
+
+    for (auto it = m_symbolRefs.cbegin(); it != m_symbolRefs.cend(); ++it) requestSymbolInfo(it.key());
+
+    // Poll until the new stream is up (in-process streams connect immediately)
+    if (!m_fallbackTimer->isActive()) m_fallbackTimer->start();
+    pollFallback();
+    if (m_streamingEnabled) openStream();
+}
+
+void MarketDataHub::closeStream() {
+    // abort() emits disconnected() synchronously; this is not a connection loss
+    m_reopeningStream = true;
+    m_socket->abort();
+    m_reopeningStream = false;
+    m_localStreamTimer->stop();
+}
+
+void MarketDataHub::openStream() {
+    m_reconnectTimer->stop();
+    if (!m_streamingEnabled || m_replaying) return;
+
+    closeStream();
+
+    if (isLocalTransport()) {
+        qDebug() << "Opening in-process market data stream:" << m_adapter->name();
+        m_localStreamTimer->start(m_adapter->streamPollIntervalMs());
+        onStreamConnected();
+        return;
+    }
+
+    const QUrl url = m_adapter->streamUrl();
+    qDebug() << "Opening market data stream:" << url.toString();
+    m_socket->open(url);
+}
+
+void MarketDataHub::pollLocalStreams() {
+    std::vector<QByteArray> frames;
+    m_adapter->pollStreams(streamNames(), frames);
+    for (const QByteArray& frame : frames) processStream(frame);
+}
+
+void MarketDataHub::onStreamConnected() {
+    m_fallbackTimer->stop();
+
+    if (!m_streamRefs.isEmpty()) sendStreamRequest(true, streamNames());
+
+    // Diff events are buffered by DepthSync until each snapshot lands
+    resetBooks();
+    for (auto it = m_depth.cbegin(); it != m_depth.cend(); ++it) requestDepthSnapshot(it.key());
+
+    emit streamConnectionChanged(true);
+}
+
+void MarketDataHub::onStreamDisconnected() {
+    if (m_reopeningStream || !m_streamingEnabled || m_replaying) return;
+
+    qDebug() << "Market data stream disconnected:" << m_socket->closeReason();
+    resetBooks();
+
+    if (!m_fallbackTimer->isActive()) m_fallbackTimer->start();
+    m_reconnectTimer->start();
+
+    emit streamConnectionChanged(false);
+}
+
+void MarketDataHub::onStreamMessage(const QString& message) {
+    processStream(message.toUtf8());
+}
+
+void MarketDataHub::processStream(const QByteArray& payload) {
+    QByteArray pair, name;
+    if (m_recorder.isOpen() || !m_tradeStreams.isEmpty()) m_adapter->describeFrame(payload, pair, name);
+    if (m_recorder.isOpen()) m_recorder.append(FeedRecord::Source::Stream, 0, pair, name, payload);
+
+    const qint64 receivedMs = QDateTime::currentMSecsSinceEpoch();
+    std::shared_ptr<const ExchangeAdapter> adapter = m_adapter;
+
+    // Trades need no ordering against the other streams: straight to the tape
+    if (m_tradeStreams.contains(name)) {
+        m_decoder.runSerial([this, adapter, payload, receivedMs]() {
+            const StreamMessage decoded = m_decoder.decodeStream(*adapter, payload);
+            if (decoded.type != StreamMessage::Type::Trade) return;
+            TapeEntry entry;
+            entry.trade = decoded.trade;
+            entry.trade.symbol = adapter->symbolFromExchange(decoded.exchangeSymbol);
+            entry.eventTimeMs = decoded.eventTimeMs;
+            entry.receivedMs = receivedMs;
+            m_tradeTape.push(std::move(entry));
+        });
+        return;
+    }
+
+    const quint64 sequence = m_nextStreamSequence++;
+
+    m_decoder.run([this, adapter, sequence, payload, receivedMs]() {
+        StreamMessage decoded = m_decoder.decodeStream(*adapter, payload);
+        QMetaObject::invokeMethod(this, [this, sequence, decoded, receivedMs]() {
+            onStreamDecoded(sequence, decoded, receivedMs);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void MarketDataHub::onStreamDecoded(quint64 sequence, const StreamMessage& message, qint64 receivedMs) {
+    m_decodedStream.emplace(sequence, std::make_pair(message, receivedMs));
+
+    // Workers may finish out of order; diffs must not
+    while (!m_decodedStream.empty() && m_decodedStream.begin()->first == m_nextAppliedSequence) {
+        auto node = m_decodedStream.extract(m_decodedStream.begin());
+        ++m_nextAppliedSequence;
+        handleStreamMessage(node.mapped().first, node.mapped().second);
+    }
+}
+
+void MarketDataHub::pollFallback() {
+    // Only books on screen are polled; live books wait for the stream
+    for (auto it = m_depth.cbegin(); it != m_depth.cend(); ++it) {
+        if (it->viewers > 0) requestDepthPoll(it.key());
+    }
+    for (auto it = m_tickerRefs.cbegin(); it != m_tickerRefs.cend(); ++it) requestTicker(it.key());
+
+    m_fallbackTimer->setInterval(m_scheduler->pollIntervalMs(FALLBACK_POLL_MS));
+}
+
+void MarketDataHub::refreshTradeStreams() {
+    m_tradeStreams.clear();
+    for (auto it = m_streamRefs.cbegin(); it != m_streamRefs.cend(); ++it) {
+        if (it.key().stream == Stream::Trade) m_tradeStreams.insert(streamName(it.key()).toLatin1());
+    }
+
+    if (m_tradeStreams.isEmpty()) m_tapeTimer->stop();
+    else if (!m_tapeTimer->isActive()) m_tapeTimer->start();
+}
+
+void MarketDataHub::drainTradeTape() {
+    // One batch per frame: a burst of prints costs one signal, not one per print
+    m_tapeBatch.trades.clear();
+    m_tradeTape.drain([this](TapeEntry&& entry) {
+        recordLatency(Stream::Trade, entry.eventTimeMs, entry.receivedMs);
+        m_tapeBatch.trades.push_back(std::move(entry.trade));
+    });
+    if (m_tapeBatch.trades.empty()) return;
+
+    m_tapeBatch.dropped = m_tradeTape.dropped();
+    emit tradesReceived(m_tapeBatch);
+}
+
+void MarketDataHub::recordLatency(Stream stream, qint64 eventTimeMs, qint64 receivedMs) {
+    if (eventTimeMs <= 0) return;
+
+    double latencyMs = static_cast<double>(receivedMs - eventTimeMs);
+    FeedLatency& stats = m_latency[stream];
+    stats.samples++;
+    stats.lastMs = latencyMs;
+    stats.avgMs += (latencyMs - stats.avgMs) / stats.samples;
+    if (latencyMs > stats.maxMs) stats.maxMs = latencyMs;
+}
+
+// ==========================================
+// Stream events
+// ==========================================
+
+void MarketDataHub::handleStreamMessage(const StreamMessage& message, qint64 receivedMs) {
+    const QString symbol = m_adapter->symbolFromExchange(message.exchangeSymbol);
+
+    switch (message.type) {
+    case StreamMessage::Type::Depth:
+        recordLatency(Stream::Depth, message.eventTimeMs, receivedMs);
+        handleDepthEvent(symbol, message.depth);
+        break;
+    case StreamMessage::Type::Kline: {
+        recordLatency(Stream::Kline, message.eventTimeMs, receivedMs);
+        Kline kline = message.kline;
+        kline.symbol = symbol;
+        emit klineUpdated(kline);
+        break;
+    }
+    case StreamMessage::Type::Ticker: {
+        recordLatency(Stream::Ticker24h, message.eventTimeMs, receivedMs);
+        Ticker24h ticker = message.ticker;
+        ticker.symbol = symbol;
+        emit tickerUpdated(ticker);
+        break;
+    }
+    case StreamMessage::Type::Trade:
+        // Subscribed trade streams go through the tape; this is a stream just unsubscribed
+        break;
+    case StreamMessage::Type::None:
+        break;
+    }
+}
+
+void MarketDataHub::handleDepthEvent(const QString& symbol, const DepthDiff& diff) {
+    auto it = m_depth.find(symbol);
+    if (it == m_depth.end()) return;
+
+    // Same shard for every event of a symbol: applied in arrival order
+    BookShard* shard = it->shard;
+    shard->post([shard, symbol, diff]() { shard->applyDiff(symbol, diff); });
+}
+
+void MarketDataHub::publishMetrics(const QString& symbol, int64_t lastUpdateId, const L2Book& book) {
+    BookMetrics metrics;
+    metrics.symbol = symbol;
+    metrics.lastUpdateId = lastUpdateId;
+    metrics.stats = BookAnalytics::compute(book);
+    emit bookMetricsUpdated(metrics);
+}
+
+// ==========================================
+// REST
+// ==========================================
+
+RequestScheduler::Priority MarketDataHub::priority(RestKind kind) {
+    switch (kind) {
+    case RestKind::DepthSnapshot: return RequestScheduler::Priority::Critical;  // Book is stalled without it
+    case RestKind::DepthPoll:     return RequestScheduler::Priority::High;
+    case RestKind::Klines:        return RequestScheduler::Priority::Normal;
+    case RestKind::ExchangeInfo:
+    case RestKind::Ticker:        return RequestScheduler::Priority::Low;
+    }
+    return RequestScheduler::Priority::Low;
+}
+
+bool MarketDataHub::get(const RestContext& context, const ExchangeAdapter::RestCall& call, const QString& key,
+                        RequestScheduler::Policy policy) {
+    // Replies come from the log during a replay
+    if (m_replaying) return false;
+
+    if (isLocalTransport()) {
+        // No network, no budget: answer on the next event loop turn like a reply would
+        RestContext current = context;
+        current.generation = m_scheduler->generation(context.symbol);
+        const QByteArray payload = m_adapter->serve(call);
+        QMetaObject::invokeMethod(this, [this, current, payload]() {
+            if (isCurrent(current)) processRest(current, payload);
+        }, Qt::QueuedConnection);
+        return true;
+    }
+
+    RequestScheduler::Request request;
+    request.key = key;
+    request.symbol = context.symbol;
+    request.url = call.url;
+    request.policy = policy;
+    request.priority = context.background ? RequestScheduler::Priority::Low : priority(context.kind);
+    request.weight = call.weight;
+    request.properties.insert("kind", static_cast<int>(context.kind));
+    request.properties.insert("symbol", context.symbol);
+    request.properties.insert("interval", context.interval);
+    request.properties.insert("requestId", context.requestId);
+    request.properties.insert("endTime", context.endTime);
+    return m_scheduler->submit(request);
+}
+
+bool MarketDataHub::isCurrent(const RestContext& context) const {
+    return m_scheduler->isCurrent(context.symbol, context.generation);
+}
+
+void MarketDataHub::requestDepthSnapshot(const QString& symbol) {
+    auto it = m_depth.find(symbol);
+    if (it == m_depth.end() || it->snapshotInFlight || m_replaying) return;
+    it->snapshotInFlight = true;
+
+    // Books nobody looks at sync shallower and yield to on-screen requests
+    RestContext context{RestKind::DepthSnapshot, symbol};
+    context.background = it->viewers == 0;
+    const int limit = context.background ? LIVE_SNAPSHOT_DEPTH_LIMIT : SNAPSHOT_DEPTH_LIMIT;
+    get(context, m_adapter->depthCall(symbol, limit), "depth-snapshot:" + symbol);
+}
+
+void MarketDataHub::clearSnapshotInFlight(const QString& symbol) {
+    auto it = m_depth.find(symbol);
+    if (it != m_depth.end()) it->snapshotInFlight = false;
+}
+
+void MarketDataHub::retryDepthSnapshot(const QString& symbol, qint64 delayMs) {
+    // The book keeps buffering diffs until a snapshot lands; a reconnect requests one anyway
+    clearSnapshotInFlight(symbol);
+    if (!isStreamConnected()) return;
+    QTimer::singleShot(static_cast<int>(delayMs), this, [this, symbol]() { requestDepthSnapshot(symbol); });
+}
+
+void MarketDataHub::requestDepthPoll(const QString& symbol) {
+    get({RestKind::DepthPoll, symbol}, m_adapter->depthCall(symbol, BOOK_PUBLISH_DEPTH), "depth:" + symbol);
+}
+
+void MarketDataHub::requestTicker(const QString& symbol) {
+    get({RestKind::Ticker, symbol}, m_adapter->tickerCall(symbol), "ticker:" + symbol);
+}
+
+void MarketDataHub::requestSymbolInfo(const QString& symbol) {
+    if (m_symbolInfoRequested.contains(symbol)) return;
+    m_symbolInfoRequested.insert(symbol);
+    get({RestKind::ExchangeInfo, symbol}, m_adapter->exchangeInfoCall(symbol), "exchangeInfo:" + symbol);
+}
+
+quint64 MarketDataHub::requestKlines(const QString& symbol, const QString& interval, int limit,
+                                     const QString& channel) {
+    const quint64 requestId = m_nextKlinesRequestId++;
+    if (m_replaying) {
+        // Answered with the next recorded klines reply for this pair
+        m_replayKlineRequests.insert(symbol + ":" + interval, requestId);
+        return requestId;
+    }
+
+    const QString key = "klines:" + (channel.isEmpty() ? symbol + ":" + interval : channel);
+    get({RestKind::Klines, symbol, interval, requestId}, m_adapter->klinesCall(symbol, interval, limit, 0), key,
+        RequestScheduler::Policy::Replace);
+    return requestId;
+}
+
+quint64 MarketDataHub::requestKlinePage(const QString& symbol, const QString& interval, qint64 endTime, int limit,
+                                        const QString& channel) {
+    const quint64 requestId = m_nextKlinesRequestId++;
+    RestContext context{RestKind::Klines, symbol, interval, requestId};
+
+    if (const std::vector<Kline>* page = m_klineCache.find(KlineCache::key(symbol, interval, endTime))) {
+        // Published on the next event loop turn, like a reply
+        std::vector<Kline> klines = *page;
+        QMetaObject::invokeMethod(this, [this, context, klines]() {
+            handleKlines(context, klines);
+        }, Qt::QueuedConnection);
+        return requestId;
+    }
+
+    context.endTime = endTime;
+    if (m_replaying) {
+        // Answered by the recorded page, or empty once the log runs out
+        m_replayPageRequests.insert(KlineCache::key(symbol, interval, endTime), context);
+        return requestId;
+    }
+
+    const QString key = "klines:" + (channel.isEmpty() ? symbol + ":" + interval : channel);
+    get(context, m_adapter->klinesCall(symbol, interval, limit, endTime), key, RequestScheduler::Policy::Replace);
+    return requestId;
+}
+
+void MarketDataHub::onHttpResponse(QNetworkReply* reply) {
+    reply->deleteLater();
+
+    const RestKind kind = static_cast<RestKind>(reply->property("kind").toInt());
+    const QString symbol = reply->property("symbol").toString();
+
+    if (reply->error() != QNetworkReply::NoError) {
+        qDebug() << "HTTP error:" << reply->errorString();
+        if (kind == RestKind::ExchangeInfo) {
+            // Keep the bundled rules, retry on the next subscription
+            m_symbolInfoRequested.remove(symbol);
+        } else if (kind == RestKind::DepthSnapshot) {
+            retryDepthSnapshot(symbol, RECONNECT_DELAY_MS);
+        }
+        return;
+    }
+
+    int statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (statusCode != 200) {
+        qDebug() << "HTTP status:" << statusCode;
+        if (kind == RestKind::DepthSnapshot) {
+            // Throttled: asking again before the scheduler's pause ends is pointless
+            retryDepthSnapshot(symbol, std::max<qint64>(RECONNECT_DELAY_MS, m_scheduler->pauseRemainingMs()));
+        }
+        return;
+    }
+
+    RestContext context;
+    context.kind = kind;
+    context.symbol = symbol;
+    context.interval = reply->property("interval").toString();
+    context.requestId = reply->property("requestId").toULongLong();
+    context.endTime = reply->property("endTime").toLongLong();
+    context.generation = reply->property("generation").toULongLong();
+    if (!isCurrent(context)) return;
+
+    processRest(context, reply->readAll());
+}
+
+void MarketDataHub::processRest(const RestContext& context, const QByteArray& payload) {
+    if (m_recorder.isOpen()) {
+        // History pages keep their end time so a replay routes them to the page request
+        QByteArray detail = context.interval.toUtf8();
+        if (context.endTime > 0) detail += '@' + QByteArray::number(context.endTime);
+        m_recorder.append(FeedRecord::Source::Rest, static_cast<quint8>(context.kind),
+                          context.symbol.toUtf8(), detail, payload);
+    }
+    std::shared_ptr<const ExchangeAdapter> adapter = m_adapter;
+    m_decoder.run([this, adapter, context, payload]() { decodeRest(*adapter, context, payload); });
+}
+
+void MarketDataHub::decodeRest(const ExchangeAdapter& adapter, const RestContext& context, const QByteArray& payload) {
+    // Worker thread: only the decoder and the queued hand-off are touched here
+    switch (context.kind) {
+    case RestKind::DepthSnapshot:
+    case RestKind::DepthPoll: {
+        DepthSnapshot snapshot;
+        bool ok = m_decoder.decodeDepth(adapter, payload, snapshot);
+        QMetaObject::invokeMethod(this, [this, context, snapshot, ok]() {
+            if (context.kind == RestKind::DepthSnapshot) {
+                if (!ok) {
+                    qDebug() << "Invalid depth snapshot, retrying" << context.symbol;
+                    retryDepthSnapshot(context.symbol, RECONNECT_DELAY_MS);
+                    return;
+                }
+                clearSnapshotInFlight(context.symbol);
+                if (isCurrent(context)) handleDepthSnapshot(context.symbol, snapshot);
+            } else if (ok && isCurrent(context)) {
+                handleDepthPoll(context.symbol, snapshot);
+            }
+        }, Qt::QueuedConnection);
+        break;
+    }
+    case RestKind::Klines: {
+        std::vector<Kline> klines;
+        if (!m_decoder.decodeKlines(adapter, payload, klines)) {
+            qDebug() << "Invalid JSON array received for klines.";
+            return;
+        }
+        QMetaObject::invokeMethod(this, [this, context, klines]() {
+            if (isCurrent(context)) handleKlines(context, klines);
+        }, Qt::QueuedConnection);
+        break;
+    }
+    case RestKind::Ticker: {
+        Ticker24h ticker;
+        if (!m_decoder.decodeTicker(adapter, payload, ticker)) return;
+        QMetaObject::invokeMethod(this, [this, context, ticker]() {
+            if (isCurrent(context)) handleTicker(ticker);
+        }, Qt::QueuedConnection);
+        break;
+    }
+    case RestKind::ExchangeInfo: {
+        std::vector<SymbolInfo> symbols;
+        if (!adapter.decodeExchangeInfo(payload, symbols)) return;
+        QMetaObject::invokeMethod(this, [symbols]() {
+            SymbolRegistry::instance()->update(symbols);
+        }, Qt::QueuedConnection);
+        break;
+    }
+    }
+}
+
+void MarketDataHub::handleDepthSnapshot(const QString& symbol, const DepthSnapshot& snapshot) {
+    auto it = m_depth.find(symbol);
+    if (it == m_depth.end()) return;
+
+    BookShard* shard = it->shard;
+    shard->post([shard, symbol, snapshot]() { shard->applySnapshot(symbol, snapshot); });
+}
+
+void MarketDataHub::handleDepthPoll(const QString& symbol, const DepthSnapshot& snapshot) {
+    // Polled depth is superseded as soon as the stream is synced
+    auto it = m_depth.find(symbol);
+    if (it == m_depth.end() || it->synced || it->viewers == 0) return;
+
+    BookUpdate update;
+    update.symbol = symbol;
+    update.lastUpdateId = snapshot.lastUpdateId;
+    update.fromStream = false;
+    update.reset = true;
+    update.bids = snapshot.bids;
+    update.asks = snapshot.asks;
+    emit bookUpdated(update);
+
+    L2Book book;
+    book.applySnapshot(snapshot.bids, snapshot.asks);
+    publishMetrics(symbol, snapshot.lastUpdateId, book);
+}
+
+void MarketDataHub::handleKlines(const RestContext& context, std::vector<Kline> klines) {
+    KlineBatch batch;
+    batch.requestId = context.requestId;
+    batch.symbol = context.symbol;
+    batch.interval = context.interval;
+    for (Kline& kline : klines) {
+        kline.symbol = context.symbol;
+        kline.interval = context.interval;
+    }
+    // Pages are closed history (see requestKlinePage()), so they never change
+    if (context.endTime > 0) m_klineCache.insert(KlineCache::key(context.symbol, context.interval, context.endTime), klines);
+    batch.klines = std::move(klines);
+    emit klinesReceived(batch);
+}
+
+void MarketDataHub::handleTicker(Ticker24h ticker) {
+    ticker.symbol = m_adapter->symbolFromExchange(ticker.symbol);
+    emit tickerUpdated(ticker);
+}
+
+// ==========================================
+// Recording / replay
+// ==========================================
+
+bool MarketDataHub::startRecording(const QString& path) {
+    if (!m_recorder.open(path)) return false;
+    qDebug() << "Recording market data to" << path;
+    return true;
+}
+
+void MarketDataHub::stopRecording() {
+    if (!m_recorder.isOpen()) return;
+    m_recorder.close();
+    qDebug() << "Recorded" << m_recorder.recordCount() << "payloads," << m_recorder.bytesWritten() << "bytes";
+}
+
+bool MarketDataHub::startReplay(const QString& path, double speed) {
+    if (!m_replayer) {
+        m_replayer = new FeedReplayer(this);
+        connect(m_replayer, &FeedReplayer::recordReady, this, &MarketDataHub::replayRecord);
+        connect(m_replayer, &FeedReplayer::finished, this, [this](quint64 records, quint64 bytes, qint64 elapsedMs) {
+            const double seconds = std::max<qint64>(elapsedMs, 1) / 1000.0;
+            qDebug() << "Replay finished:" << records << "payloads in" << elapsedMs << "ms,"
+                     << (bytes / (1024.0 * 1024.0)) / seconds << "MB/s";
+            answerReplayPages();
+            emit replayFinished(records, bytes, elapsedMs);
+        });
+    }
+    if (!m_replayer->open(path)) return false;
+    answerReplayPages();
+
+    // Cut the exchange off: every payload now comes from the log
+    const bool wasReplaying = m_replaying;
+    m_replaying = true;
+    m_reconnectTimer->stop();
+    m_fallbackTimer->stop();
+    closeStream();
+    resetBooks();
+    for (DepthState& state : m_depth) state.snapshotInFlight = false;
+
+    qDebug() << "Replaying market data from" << path << "at speed" << speed;
+    m_replayer->start(speed);
+    if (!wasReplaying) emit streamConnectionChanged(true);
+    return true;
+}
+
+void MarketDataHub::replayRecord(const FeedRecord& record) {
+    if (record.source == FeedRecord::Source::Stream) {
+        processStream(record.payload);
+        return;
+    }
+
+    RestContext context;
+    context.kind = static_cast<RestKind>(record.kind);
+    context.symbol = QString::fromUtf8(record.symbol);
+    context.interval = QString::fromUtf8(record.detail);
+    context.generation = m_scheduler->generation(context.symbol);
+    if (context.kind == RestKind::Klines) {
+        const int at = record.detail.indexOf('@');
+        if (at >= 0) {
+            // A history page: only the page request for the same end time gets it
+            context.interval = QString::fromUtf8(record.detail.left(at));
+            context.endTime = record.detail.mid(at + 1).toLongLong();
+            context.requestId = m_replayPageRequests.take(
+                KlineCache::key(context.symbol, context.interval, context.endTime)).requestId;
+        } else {
+            context.requestId = m_replayKlineRequests.take(context.symbol + ":" + context.interval);
+        }
+    }
+    processRest(context, record.payload);
+}
+
+void MarketDataHub::answerReplayPages() {
+    // The log holds no such page: an empty one tells the chart there is nothing older
+    // (taken first: a receiver may ask for another page)
+    const QHash<QString, RestContext> pending = std::exchange(m_replayPageRequests, {});
+    for (RestContext context : pending) {
+        context.endTime = 0;    // Not cached: a later replay may hold the page
+        handleKlines(context, {});
+    }
+}
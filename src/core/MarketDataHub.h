@@ -0,0 +1,324 @@
+/**
+ * @file MarketDataHub.h
+ * @brief Shared market data service feeding every widget.
+ *
+ * The hub owns the only network connections of the application:
+ * - One QNetworkAccessManager for all REST calls
+ * - One combined-stream WebSocket per exchange, multiplexing every
+ *   subscribed stream through SUBSCRIBE / UNSUBSCRIBE requests
+ *
+ * Everything venue-specific (symbols, URLs, stream names, wire format) is
+ * delegated to an ExchangeAdapter (Binance by default, see setAdapter()).
+ *
+ * Subscriptions are reference counted per stream/symbol/interval, so any
+ * number of widgets can follow the same symbol without extra traffic.
+ * REST calls go through a RequestScheduler (one request in flight per
+ * endpoint, stale replies dropped, polling adapted to RTT and weight usage).
+ * Payloads are decoded once, off the GUI thread (see FeedDecoder), and
+ * published as typed events (BookUpdate, Kline, Ticker24h, Trade). Books are
+ * published as a full reset once synced, then as per-level changes.
+ *
+ * Books are kept on BookShard worker threads, each symbol pinned to one
+ * shard. Besides the books widgets subscribe to, setLiveBooks() keeps a set
+ * of symbols synced in the background: they feed BookMetrics (cross-symbol
+ * analytics) but no BookUpdate until a widget subscribes, which then gets
+ * the full book at once instead of waiting for a snapshot. Books are
+ * checksummed after every update; on a gap or checksum mismatch the stale
+ * book stays published, flagged as resyncing, until a new snapshot lands.
+ * Trades bypass the ordered dispatch: frames of trade streams are decoded
+ * on a serial decoder lane that pushes them into a lock-free SPSC ring (the
+ * trade tape), drained on the hub thread once per frame and published as
+ * one TradeBatch, however many prints arrived.
+ * Older chart history is paged with endTime requests; closed pages are kept
+ * in an LRU KlineCache and served from it without a request.
+ * Feed latency and decode cost are measured here.
+ *
+ * Every raw payload can be recorded to a binary log (FeedLog.h) and replayed
+ * later through the same decode path, with the exchange disconnected.
+ */
+
+#ifndef MARKETDATAHUB_H
+#define MARKETDATAHUB_H
+
+#include <QObject>
+#include <QHash>
+#include <QMap>
+#include <QSet>
+#include <QThread>
+#include <QVector>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QTimer>
+#include <QWebSocket>
+#include <map>
+#include <memory>
+#include <tuple>
+#include "BookShard.h"
+#include "ExchangeAdapter.h"
+#include "FeedDecoder.h"
+#include "FeedLog.h"
+#include "KlineCache.h"
+#include "MarketEvents.h"
+#include "RequestScheduler.h"
+#include "SpscRing.h"
+
+/**
+ * @class MarketDataHub
+ * @brief Single owner of exchange connections, publishing typed market events.
+ */
+class MarketDataHub : public QObject {
+    Q_OBJECT
+
+public:
+    using Stream = MarketStream;
+
+    static constexpr int BOOK_PUBLISH_DEPTH = 100;     // Levels per side of the REST fallback book
+    static constexpr int SNAPSHOT_DEPTH_LIMIT = 5000;  // Levels per side of the sync snapshot (venue max)
+    static constexpr int LIVE_SNAPSHOT_DEPTH_LIMIT = 1000; // Background books: weight 50 instead of 250
+    static constexpr int MAX_BOOK_SHARDS = 4;
+    static constexpr int FALLBACK_POLL_MS = 1000;
+    static constexpr int RECONNECT_DELAY_MS = 2000;
+    static constexpr size_t TRADE_TAPE_CAPACITY = 16384;   // Prints buffered between two drains
+    static constexpr int TRADE_TAPE_DRAIN_MS = 16;
+
+    /// Application-wide instance, created on first use.
+    static MarketDataHub* instance();
+
+    /**
+     * Adds a reference to a stream. The underlying exchange stream is only
+     * subscribed on the first reference. @p interval is used by Kline only.
+     */
+    void subscribe(Stream stream, const QString& symbol, const QString& interval = QString());
+    void unsubscribe(Stream stream, const QString& symbol, const QString& interval = QString());
+
+    /**
+     * Keeps the depth books of @p symbols synced whether displayed or not
+     * (e.g. the top USDT pairs), replacing the previous set.
+     */
+    void setLiveBooks(const QStringList& symbols);
+    QStringList liveBooks() const { return QStringList(m_liveBooks.cbegin(), m_liveBooks.cend()); }
+
+    /// Checksum, resync flag and gap / checksum-failure / resync counters of a synced book.
+    BookIntegrity bookIntegrity(const QString& symbol) const { return m_depth.value(symbol).integrity; }
+
+    /**
+     * One-shot REST klines request; the result is published via klinesReceived().
+     * Requests on the same @p channel supersede each other: a pending one is
+     * aborted and never published. The default channel is symbol + interval.
+     */
+    quint64 requestKlines(const QString& symbol, const QString& interval, int limit,
+                          const QString& channel = QString());
+
+    /**
+     * Page of @p limit closed candles opening at or before @p endTime, published
+     * via klinesReceived() like requestKlines(). Served from the kline cache
+     * (keyed by symbol / interval / @p endTime) when present, so callers should
+     * align @p endTime on page boundaries and only page closed history;
+     * fetched and cached otherwise.
+     */
+    quint64 requestKlinePage(const QString& symbol, const QString& interval, qint64 endTime, int limit,
+                             const QString& channel = QString());
+
+    /// Poll period to use instead of @p baseMs given current RTT and weight usage.
+    int pollIntervalMs(int baseMs) const { return m_scheduler->pollIntervalMs(baseMs); }
+
+    /// Remaining weight budget, queue depth per priority and request counters.
+    RequestScheduler::Metrics requestMetrics() const { return m_scheduler->metrics(); }
+
+    /// Switches between the WebSocket feed (default) and plain REST polling.
+    void setStreamingEnabled(bool enabled);
+    bool isStreamingEnabled() const { return m_streamingEnabled; }
+    bool isStreamConnected() const;
+
+    /**
+     * Switches venue. Pending requests are dropped, books resynced and every
+     * current subscription re-established through the new adapter.
+     */
+    void setAdapter(std::shared_ptr<ExchangeAdapter> adapter);
+    const ExchangeAdapter& adapter() const { return *m_adapter; }
+
+    /// Appends every raw REST reply and stream frame to @p path.
+    bool startRecording(const QString& path);
+    void stopRecording();
+
+    /**
+     * Disconnects from the exchange and plays a recorded log through the
+     * normal decode path. @p speed: 1 = recorded pacing, N = N times faster,
+     * 0 = as fast as possible.
+     */
+    bool startReplay(const QString& path, double speed);
+    bool isReplaying() const { return m_replaying; }
+
+    FeedLatency latency(Stream stream) const { return m_latency.value(stream); }
+    DecodeStats decodeStats(FeedDecoder::MessageType type) const { return m_decoder.stats(type); }
+
+signals:
+    void bookUpdated(const BookUpdate& update);
+    void bookMetricsUpdated(const BookMetrics& metrics);
+    void klineUpdated(const Kline& kline);
+    void klinesReceived(const KlineBatch& batch);
+    void tickerUpdated(const Ticker24h& ticker);
+    /// Trades of every subscribed symbol since the previous batch, once per frame at most.
+    void tradesReceived(const TradeBatch& batch);
+    void streamConnectionChanged(bool connected);
+    void replayFinished(quint64 records, quint64 bytes, qint64 elapsedMs);
+
+private slots:
+    void onHttpResponse(QNetworkReply* reply);
+    void onStreamConnected();
+    void onStreamDisconnected();
+    void onStreamMessage(const QString& message);
+    void openStream();
+    void pollFallback();
+    void pollLocalStreams();
+    void onBookSynced(const QString& symbol);
+    void onBookMetrics(const BookMetrics& metrics);
+    void onSnapshotNeeded(const QString& symbol);
+    void drainTradeTape();
+
+private:
+    explicit MarketDataHub(QObject* parent = nullptr);
+    ~MarketDataHub() override;
+
+    enum class RestKind { DepthSnapshot, DepthPoll, Klines, Ticker, ExchangeInfo };
+
+    // Hub-side view of a book; the book itself lives on its shard
+    struct DepthState {
+        BookShard* shard = nullptr;
+        int viewers = 0;                // Widget subscriptions (receive BookUpdates)
+        bool live = false;              // Kept synced by setLiveBooks()
+        bool synced = false;            // Last reported by the shard
+        bool snapshotInFlight = false;
+        BookIntegrity integrity;        // Last reported by the shard
+    };
+
+    struct StreamKey {
+        Stream stream;
+        QString symbol;
+        QString interval;       // Kline only
+
+        bool operator<(const StreamKey& other) const {
+            return std::tie(stream, symbol, interval) < std::tie(other.stream, other.symbol, other.interval);
+        }
+    };
+
+    struct RestContext {
+        RestKind kind;
+        QString symbol;
+        QString interval;
+        quint64 requestId = 0;
+        quint64 generation = 0;     // RequestScheduler generation of symbol
+        bool background = false;    // For a book nobody displays: lowest priority
+        qint64 endTime = 0;         // Kline pages: cached under it on arrival
+    };
+
+    QString streamName(const StreamKey& key) const;
+    QStringList streamNames() const;
+    bool isLocalTransport() const { return m_adapter->transport() == ExchangeAdapter::Transport::InProcess; }
+
+    // Subscription bookkeeping; @p viewer is false for live books
+    void acquire(const StreamKey& key, bool viewer);
+    void release(const StreamKey& key, bool viewer);
+    void retainBook(const QString& symbol, bool viewer);
+    void releaseBook(const QString& symbol, bool viewer);
+    BookShard* shardFor(const QString& symbol) const;
+    void resetBooks();
+    void refreshTradeStreams();
+
+    static RequestScheduler::Priority priority(RestKind kind);
+
+    /**
+     * Queues @p call on the scheduler, or asks an in-process adapter directly.
+     * @return false if coalesced or replaying.
+     */
+    bool get(const RestContext& context, const ExchangeAdapter::RestCall& call, const QString& key,
+             RequestScheduler::Policy policy = RequestScheduler::Policy::Coalesce);
+    bool isCurrent(const RestContext& context) const;
+    void sendStreamRequest(bool subscribe, const QStringList& streams);
+    void closeStream();
+    void requestDepthSnapshot(const QString& symbol);
+    void clearSnapshotInFlight(const QString& symbol);
+    void retryDepthSnapshot(const QString& symbol, qint64 delayMs);
+    void requestDepthPoll(const QString& symbol);
+    void requestTicker(const QString& symbol);
+    void requestSymbolInfo(const QString& symbol);
+
+    // Entry points shared by live traffic and replay
+    void processRest(const RestContext& context, const QByteArray& payload);
+    void processStream(const QByteArray& payload);
+    void replayRecord(const FeedRecord& record);
+    void answerReplayPages();
+
+    // Runs on a decoder worker, posts the result back to the hub thread
+    void decodeRest(const ExchangeAdapter& adapter, const RestContext& context, const QByteArray& payload);
+    void onStreamDecoded(quint64 sequence, const StreamMessage& message, qint64 receivedMs);
+
+    void handleDepthSnapshot(const QString& symbol, const DepthSnapshot& snapshot);
+    void handleDepthPoll(const QString& symbol, const DepthSnapshot& snapshot);
+    void handleKlines(const RestContext& context, std::vector<Kline> klines);
+    void handleTicker(Ticker24h ticker);
+    void handleStreamMessage(const StreamMessage& message, qint64 receivedMs);
+    void handleDepthEvent(const QString& symbol, const DepthDiff& diff);
+
+    void publishMetrics(const QString& symbol, int64_t lastUpdateId, const L2Book& book);
+    void recordLatency(Stream stream, qint64 eventTimeMs, qint64 receivedMs);
+
+    QNetworkAccessManager* m_networkManager;
+    RequestScheduler* m_scheduler;
+    QWebSocket* m_socket;
+    QTimer* m_reconnectTimer;
+    QTimer* m_fallbackTimer;
+    QTimer* m_localStreamTimer;     // Drives in-process adapters instead of the socket
+    std::shared_ptr<ExchangeAdapter> m_adapter;
+
+    // Trade tape: produced by the decoder's serial lane, consumed by drainTradeTape().
+    // Declared before m_decoder so it outlives the lane's last job.
+    struct TapeEntry {
+        Trade trade;
+        qint64 eventTimeMs = 0;
+        qint64 receivedMs = 0;
+    };
+    SpscRing<TapeEntry> m_tradeTape{TRADE_TAPE_CAPACITY};
+    TradeBatch m_tapeBatch;         // Reused across drains
+    QTimer* m_tapeTimer;
+    QSet<QByteArray> m_tradeStreams;    // Exchange stream names routed to the tape
+
+    FeedDecoder m_decoder;
+    FeedRecorder m_recorder;
+    FeedReplayer* m_replayer = nullptr;
+
+    bool m_streamingEnabled = true;
+    bool m_reopeningStream = false;
+    bool m_replaying = false;
+    int m_nextStreamRequestId = 1;
+    quint64 m_nextKlinesRequestId = 1;
+    KlineCache m_klineCache;
+
+    // Stream messages decode in parallel but are applied in arrival order
+    quint64 m_nextStreamSequence = 0;
+    quint64 m_nextAppliedSequence = 0;
+    std::map<quint64, std::pair<StreamMessage, qint64>> m_decodedStream;
+
+    // Subscribed stream -> number of subscribers
+    QMap<StreamKey, int> m_streamRefs;
+    // Application symbol -> ticker subscribers (drives the REST fallback)
+    QHash<QString, int> m_tickerRefs;
+    // Application symbol -> subscribers across all streams (drives invalidation)
+    QHash<QString, int> m_symbolRefs;
+    // Symbols whose exchangeInfo rules were already fetched this session
+    QSet<QString> m_symbolInfoRequested;
+    // Depth books, one per subscribed or live symbol
+    QHash<QString, DepthState> m_depth;
+    QSet<QString> m_liveBooks;
+    QVector<BookShard*> m_shards;
+    QVector<QThread*> m_shardThreads;
+
+    QMap<Stream, FeedLatency> m_latency;
+
+    // Replay: "symbol:interval" -> latest klines request id, answered by recorded replies
+    QHash<QString, quint64> m_replayKlineRequests;
+    // Replay: KlineCache::key of a history page -> its request, answered by the recorded page
+    QHash<QString, RestContext> m_replayPageRequests;
+};
+
+#endif // MARKETDATAHUB_H
@@ -0,0 +1,143 @@
+/**
+ * @file MarketEvents.h
+ * @brief Typed market data events published by MarketDataHub.
+ *
+ * Every event carries the application-level symbol (e.g. "BTC"), not the
+ * exchange pair, so widgets can filter on the symbol they display.
+ */
+
+#ifndef MARKETEVENTS_H
+#define MARKETEVENTS_H
+
+#include "BookAnalytics.h"
+#include "MarketTypes.h"
+#include <QMetaType>
+#include <QString>
+#include <vector>
+
+/// Stream types a widget can subscribe to.
+enum class MarketStream { Depth, Kline, Ticker24h, Trade };
+
+/**
+ * @struct BookUpdate
+ * @brief Order book change for one symbol, meant to be applied to an L2Book.
+ *
+ * A reset carries the whole book (best first) and replaces any local copy.
+ * Otherwise the levels are changes to apply in order, a zero quantity
+ * deleting the level. Consumers ignore changes until they saw a reset.
+ */
+struct BookUpdate {
+    QString symbol;
+    int64_t lastUpdateId = 0;
+    bool fromStream = false;        // false when produced by the REST fallback
+    bool reset = true;
+    std::vector<BookLevel> bids;
+    std::vector<BookLevel> asks;
+};
+
+/**
+ * @struct BookIntegrity
+ * @brief Sync state and integrity counters of one stream-maintained book.
+ */
+struct BookIntegrity {
+    uint32_t checksum = 0;          // BookChecksum after the last applied update
+    bool resyncing = false;         // Stale book kept while a new snapshot is fetched
+    int gaps = 0;                   // Sequence gaps detected
+    int checksumFailures = 0;       // Venue checksums the local book did not match
+    int resyncs = 0;                // Snapshots installed to recover from either
+};
+
+/**
+ * @struct BookMetrics
+ * @brief BookAnalytics of one symbol, published after every book update.
+ *
+ * Also published when the book loses sync, with integrity.resyncing set.
+ */
+struct BookMetrics {
+    QString symbol;
+    int64_t lastUpdateId = 0;
+    BookStats stats;
+    BookIntegrity integrity;        // Default for books polled over REST
+};
+
+/**
+ * @struct Kline
+ * @brief One candle, either historical (REST) or live (kline stream).
+ */
+struct Kline {
+    QString symbol;
+    QString interval;
+    qint64 openTime = 0;
+    double open = 0;
+    double high = 0;
+    double low = 0;
+    double close = 0;
+    double volume = 0;
+    bool closed = true;
+};
+
+/**
+ * @struct KlineBatch
+ * @brief Result of a REST klines request, oldest candle first.
+ */
+struct KlineBatch {
+    quint64 requestId = 0;
+    QString symbol;
+    QString interval;
+    std::vector<Kline> klines;
+};
+
+/**
+ * @struct Ticker24h
+ * @brief Rolling 24h statistics for one symbol.
+ */
+struct Ticker24h {
+    QString symbol;
+    double lastPrice = 0;
+    double priceChange = 0;
+    double priceChangePercent = 0;
+    double quoteVolume = 0;
+};
+
+/**
+ * @struct Trade
+ * @brief One aggregated trade print.
+ */
+struct Trade {
+    QString symbol;
+    qint64 tradeId = 0;
+    qint64 timeMs = 0;
+    double price = 0;
+    double qty = 0;
+    bool buyerIsMaker = false;
+};
+
+/**
+ * @struct TradeBatch
+ * @brief Trade prints drained from the trade tape in one frame, oldest first.
+ */
+struct TradeBatch {
+    std::vector<Trade> trades;
+    quint64 dropped = 0;            // Prints lost so far because the GUI fell behind
+};
+
+/**
+ * @struct FeedLatency
+ * @brief Exchange event time to local receive time statistics, in milliseconds.
+ */
+struct FeedLatency {
+    qint64 samples = 0;
+    double lastMs = 0;
+    double avgMs = 0;
+    double maxMs = 0;
+};
+
+Q_DECLARE_METATYPE(BookUpdate)
+Q_DECLARE_METATYPE(BookMetrics)
+Q_DECLARE_METATYPE(Kline)
+Q_DECLARE_METATYPE(KlineBatch)
+Q_DECLARE_METATYPE(Ticker24h)
+Q_DECLARE_METATYPE(Trade)
+Q_DECLARE_METATYPE(TradeBatch)
+
+#endif // MARKETEVENTS_H
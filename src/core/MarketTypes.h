@@ -0,0 +1,131 @@
+/**
+ * @file MarketTypes.h
+ * @brief Plain market data structures shared by the core feeds and the UI.
+ *
+ * These types carry no Qt dependency so they can be produced by parsers and
+ * book logic without pulling in the widget layer.
+ */
+
+#ifndef MARKETTYPES_H
+#define MARKETTYPES_H
+
+#include "FixedPoint.h"
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+/**
+ * @struct BookLevel
+ * @brief One price level of an order book side, in exact decimal units.
+ */
+struct BookLevel {
+    Price price;
+    Qty qty;
+};
+
+/**
+ * @struct DepthSnapshot
+ * @brief Full REST depth snapshot (`/api/v3/depth`).
+ */
+struct DepthSnapshot {
+    int64_t lastUpdateId = 0;
+    std::vector<BookLevel> bids;
+    std::vector<BookLevel> asks;
+};
+
+/**
+ * @struct DepthDiff
+ * @brief One diff-depth stream event covering update ids [firstUpdateId, lastUpdateId].
+ *
+ * A quantity of zero means the level must be removed from the book.
+ * Venues that checksum their book send the expected BookChecksum of the
+ * book after the event.
+ */
+struct DepthDiff {
+    int64_t firstUpdateId = 0;  // "U"
+    int64_t lastUpdateId = 0;   // "u"
+    bool hasChecksum = false;
+    uint32_t checksum = 0;      // "cs"
+    std::vector<BookLevel> bids;
+    std::vector<BookLevel> asks;
+};
+
+/**
+ * @struct Candle
+ * @brief One OHLCV candle without symbol/interval metadata.
+ */
+struct Candle {
+    int64_t openTime = 0;
+    double open = 0;
+    double high = 0;
+    double low = 0;
+    double close = 0;
+    double volume = 0;
+};
+
+/**
+ * @struct TickerStats
+ * @brief Rolling 24h statistics of one pair.
+ */
+struct TickerStats {
+    double lastPrice = 0;
+    double priceChange = 0;
+    double priceChangePercent = 0;
+    double quoteVolume = 0;
+};
+
+/**
+ * @struct TradePrint
+ * @brief One aggregated trade.
+ */
+struct TradePrint {
+    int64_t tradeId = 0;
+    int64_t timeMs = 0;
+    double price = 0;
+    double qty = 0;
+    bool buyerIsMaker = false;
+};
+
+/**
+ * @struct ShortText
+ * @brief Fixed-capacity text (symbols, intervals) that never touches the heap.
+ */
+struct ShortText {
+    static constexpr size_t CAPACITY = 23;
+
+    char data[CAPACITY + 1] = {};
+    size_t size = 0;
+
+    void assign(std::string_view text) {
+        size = text.size() < CAPACITY ? text.size() : CAPACITY;
+        for (size_t i = 0; i < size; ++i) data[i] = text[i];
+        data[size] = '\0';
+    }
+    void clear() { size = 0; data[0] = '\0'; }
+    std::string_view view() const { return std::string_view(data, size); }
+};
+
+/**
+ * @struct StreamEvent
+ * @brief One decoded WebSocket market event.
+ *
+ * Instances are meant to be reused: the level vectors keep their capacity
+ * between messages, so steady-state decoding does not allocate.
+ */
+struct StreamEvent {
+    enum class Type { None, Depth, Kline, Ticker, Trade };
+
+    Type type = Type::None;
+    ShortText symbol;           // Exchange pair, e.g. "BTCUSDT"
+    int64_t eventTimeMs = 0;
+
+    DepthDiff depth;
+    Candle kline;
+    ShortText klineInterval;
+    bool klineClosed = false;
+    TickerStats ticker;
+    TradePrint trade;
+};
+
+#endif // MARKETTYPES_H
@@ -0,0 +1,320 @@
+#include "MockExchangeAdapter.h"
+#include "BookChecksum.h"
+#include <QDateTime>
+#include <QSet>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+QByteArray price(qint64 ticks) {
+    return QByteArray::number(ticks * MockExchangeAdapter::TICK, 'f', 2);
+}
+
+QByteArray decimal(double value, int decimals) {
+    return QByteArray::number(value, 'f', decimals);
+}
+
+template <typename It>
+void appendLevels(QByteArray& out, It begin, It end, int limit) {
+    out += '[';
+    int n = 0;
+    for (It it = begin; it != end && n < limit; ++it, ++n) {
+        if (n) out += ',';
+        out += "[\"" + price(it->first) + "\",\"" + decimal(it->second, 5) + "\"]";
+    }
+    out += ']';
+}
+
+/// Best-first levels as the client parses them from the served text.
+template <typename It>
+size_t checksumLevels(It begin, It end, BookLevel* out) {
+    const int64_t tick = Price::fromDouble(MockExchangeAdapter::TICK).raw();
+    size_t n = 0;
+    for (It it = begin; it != end && n < BookChecksum::LEVELS; ++it, ++n) {
+        const QByteArray qty = decimal(it->second, 5);
+        out[n].price = Price::fromRaw(it->first * tick);
+        Qty::parse(std::string_view(qty.constData(), static_cast<size_t>(qty.size())), out[n].qty);
+    }
+    return n;
+}
+
+QByteArray envelope(const QByteArray& stream, const QByteArray& data) {
+    return "{\"stream\":\"" + stream + "\",\"data\":" + data + '}';
+}
+
+} // namespace
+
+MockExchangeAdapter::MockExchangeAdapter(quint64 seed)
+    : m_rng(seed)
+{
+}
+
+qint64 MockExchangeAdapter::intervalMs(const QString& interval) {
+    if (interval.size() < 2) return 60000;
+    const qint64 n = std::max(1, interval.left(interval.size() - 1).toInt());
+    switch (interval.back().toLatin1()) {
+    case 's': return n * 1000;
+    case 'm': return n * 60000;
+    case 'h': return n * 3600000;
+    case 'd': return n * 86400000;
+    case 'w': return n * 7 * 86400000LL;
+    case 'M': return n * 30 * 86400000LL;
+    default:  return 60000;
+    }
+}
+
+// ==========================================
+// Simulation
+// ==========================================
+
+MockExchangeAdapter::Market& MockExchangeAdapter::market(const QByteArray& pair) {
+    auto it = m_markets.find(pair);
+    if (it != m_markets.end()) return it.value();
+
+    const QString symbol = symbolFromExchange(QString::fromLatin1(pair));
+    const double base = (symbol == "BTC") ? 60000.0 : (symbol == "ETH") ? 3000.0 : 100.0;
+    std::uniform_real_distribution<double> drift(-0.03, 0.03);
+
+    Market& m = m_markets[pair];
+    m.pair = pair;
+    m.mid = base;
+    m.open24h = base * (1.0 + drift(m_rng));
+    m.quoteVolume24h = base * 20000.0;
+    step(m);
+    m.lastBidChanges.clear();
+    m.lastAskChanges.clear();
+    return m;
+}
+
+double MockExchangeAdapter::randomQty() {
+    std::exponential_distribution<double> size(2.0);
+    return std::max(0.00001, std::round(size(m_rng) * 100000.0) / 100000.0);
+}
+
+void MockExchangeAdapter::setLevel(Market& m, bool bid, qint64 ticks, double qty) {
+    auto& side = bid ? m.bids : m.asks;
+    if (qty > 0) side[ticks] = qty;
+    else side.erase(ticks);
+    (bid ? m.lastBidChanges : m.lastAskChanges).emplace_back(ticks, qty);
+}
+
+void MockExchangeAdapter::step(Market& m) {
+    m.lastBidChanges.clear();
+    m.lastAskChanges.clear();
+    ++m.updateId;
+
+    std::normal_distribution<double> ret(0.0, VOLATILITY);
+    m.mid *= std::exp(ret(m_rng));
+    const qint64 midTicks = std::llround(m.mid / TICK);
+
+    // Levels crossed by the new mid are consumed
+    while (!m.bids.empty() && m.bids.rbegin()->first >= midTicks) setLevel(m, true, m.bids.rbegin()->first, 0);
+    while (!m.asks.empty() && m.asks.begin()->first <= midTicks) setLevel(m, false, m.asks.begin()->first, 0);
+
+    // Activity concentrates near the touch
+    std::uniform_int_distribution<int> offset(1, 20);
+    std::bernoulli_distribution bidSide(0.5), cancel(0.3);
+    for (int i = 0; i < CHANGES_PER_STEP; ++i) {
+        const bool bid = bidSide(m_rng);
+        const qint64 ticks = bid ? midTicks - offset(m_rng) : midTicks + offset(m_rng);
+        setLevel(m, bid, ticks, cancel(m_rng) ? 0 : randomQty());
+    }
+
+    // Keep both sides BOOK_LEVELS deep
+    std::uniform_int_distribution<int> gap(1, 3);
+    while (static_cast<int>(m.bids.size()) < BOOK_LEVELS) {
+        const qint64 last = m.bids.empty() ? midTicks : m.bids.begin()->first;
+        setLevel(m, true, last - gap(m_rng), randomQty());
+    }
+    while (static_cast<int>(m.asks.size()) < BOOK_LEVELS) {
+        const qint64 last = m.asks.empty() ? midTicks : m.asks.rbegin()->first;
+        setLevel(m, false, last + gap(m_rng), randomQty());
+    }
+}
+
+// ==========================================
+// REST
+// ==========================================
+
+QByteArray MockExchangeAdapter::serve(const RestCall& call) {
+    Market& m = market(call.exchangeSymbol.toLatin1());
+    switch (call.endpoint) {
+    case Endpoint::Depth:        return depthSnapshot(m, call.limit);
+    case Endpoint::Klines:       return klines(m, call.interval, call.limit, call.endTime);
+    case Endpoint::Ticker24h:    return ticker(m);
+    case Endpoint::ExchangeInfo: return exchangeInfo(m);
+    }
+    return QByteArray();
+}
+
+QByteArray MockExchangeAdapter::depthSnapshot(const Market& m, int limit) const {
+    QByteArray out = "{\"lastUpdateId\":" + QByteArray::number(m.updateId) + ",\"bids\":";
+    appendLevels(out, m.bids.rbegin(), m.bids.rend(), limit);
+    out += ",\"asks\":";
+    appendLevels(out, m.asks.begin(), m.asks.end(), limit);
+    out += '}';
+    return out;
+}
+
+QByteArray MockExchangeAdapter::klines(Market& m, const QString& interval, int limit, qint64 endTime) {
+    const qint64 ms = intervalMs(interval);
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    const qint64 last = endTime > 0 ? std::min(endTime, now) : now;
+    const qint64 currentOpen = last - last % ms;
+
+    // Walk backwards from the current mid so history joins the live candle;
+    // an older page joins the oldest candle served so far where it reaches it
+    const double vol = std::min(0.05, VOLATILITY * std::sqrt(ms / 100.0));
+    std::normal_distribution<double> ret(0.0, vol);
+    std::vector<Candle> history(static_cast<size_t>(std::max(limit, 1)));
+    double close = m.mid;
+    auto oldest = m.oldest.constFind(interval);
+    const bool join = endTime > 0 && oldest != m.oldest.constEnd();
+    for (size_t i = 0; i < history.size(); ++i) {
+        Candle& c = history[history.size() - 1 - i];
+        c.openTime = currentOpen - static_cast<qint64>(i) * ms;
+        if (join && c.openTime == oldest->openTime - ms) close = oldest->open;
+        c.close = close;
+        c.open = close * std::exp(ret(m_rng));
+        c.high = std::max(c.open, c.close) * (1.0 + std::abs(ret(m_rng)) / 2);
+        c.low = std::min(c.open, c.close) * (1.0 - std::abs(ret(m_rng)) / 2);
+        c.volume = randomQty() * 100.0;
+        close = c.open;
+    }
+    if (endTime <= 0) m.candles[interval] = history.back();
+    if (endTime <= 0 || oldest == m.oldest.constEnd() || history.front().openTime < oldest->openTime) {
+        m.oldest[interval] = history.front();
+    }
+
+    QByteArray out = "[";
+    for (size_t i = 0; i < history.size(); ++i) {
+        const Candle& c = history[i];
+        if (i) out += ',';
+        out += '[' + QByteArray::number(c.openTime) + ",\"" + decimal(c.open, 2) + "\",\"" + decimal(c.high, 2)
+             + "\",\"" + decimal(c.low, 2) + "\",\"" + decimal(c.close, 2) + "\",\"" + decimal(c.volume, 5)
+             + "\"," + QByteArray::number(c.openTime + ms - 1) + ']';
+    }
+    out += ']';
+    return out;
+}
+
+QByteArray MockExchangeAdapter::ticker(const Market& m) const {
+    const double change = m.mid - m.open24h;
+    return "{\"symbol\":\"" + m.pair + "\",\"priceChange\":\"" + decimal(change, 2)
+         + "\",\"priceChangePercent\":\"" + decimal(change / m.open24h * 100.0, 3)
+         + "\",\"lastPrice\":\"" + decimal(m.mid, 2) + "\",\"quoteVolume\":\"" + decimal(m.quoteVolume24h, 2) + "\"}";
+}
+
+QByteArray MockExchangeAdapter::exchangeInfo(const Market& m) const {
+    const QByteArray base = symbolFromExchange(QString::fromLatin1(m.pair)).toLatin1();
+    return "{\"symbols\":[{\"symbol\":\"" + m.pair + "\",\"baseAsset\":\"" + base + "\",\"quoteAsset\":\""
+         + QByteArray(QUOTE_ASSET) + "\",\"filters\":["
+           "{\"filterType\":\"PRICE_FILTER\",\"tickSize\":\"0.01\"},"
+           "{\"filterType\":\"LOT_SIZE\",\"stepSize\":\"0.00001\",\"minQty\":\"0.00001\"},"
+           "{\"filterType\":\"NOTIONAL\",\"minNotional\":\"5\"}]}]}";
+}
+
+// ==========================================
+// Streams
+// ==========================================
+
+void MockExchangeAdapter::pollStreams(const QStringList& streams, std::vector<QByteArray>& frames) {
+    ++m_polls;
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    QSet<QByteArray> stepped;
+    std::bernoulli_distribution tradeHappens(0.5);
+
+    for (const QString& name : streams) {
+        const int at = name.indexOf('@');
+        if (at <= 0) continue;
+        const QByteArray stream = name.toLatin1();
+        const QByteArray pair = stream.left(at).toUpper();
+        const QString kind = name.mid(at + 1);
+
+        Market& m = market(pair);
+        if (!stepped.contains(pair)) {
+            step(m);
+            stepped.insert(pair);
+        }
+
+        if (kind.startsWith("depth")) {
+            frames.push_back(depthEvent(m, stream, now));
+        } else if (kind.startsWith("kline_")) {
+            klineEvents(m, stream, kind.mid(6), now, frames);
+        } else if (kind == "ticker") {
+            if (m_polls % TICKER_EVERY_POLLS == 0) frames.push_back(tickerEvent(m, stream, now));
+        } else if (kind == "aggTrade") {
+            if (tradeHappens(m_rng)) frames.push_back(tradeEvent(m, stream, now));
+        }
+    }
+}
+
+QByteArray MockExchangeAdapter::depthEvent(const Market& m, const QByteArray& stream, qint64 nowMs) const {
+    const QByteArray id = QByteArray::number(m.updateId);
+    QByteArray data = "{\"e\":\"depthUpdate\",\"E\":" + QByteArray::number(nowMs) + ",\"s\":\"" + m.pair
+                    + "\",\"U\":" + id + ",\"u\":" + id + ",\"b\":";
+    appendLevels(data, m.lastBidChanges.begin(), m.lastBidChanges.end(), static_cast<int>(m.lastBidChanges.size()));
+    data += ",\"a\":";
+    appendLevels(data, m.lastAskChanges.begin(), m.lastAskChanges.end(), static_cast<int>(m.lastAskChanges.size()));
+
+    // Checksum of the resulting book, signed like venues send it
+    BookLevel bids[BookChecksum::LEVELS];
+    BookLevel asks[BookChecksum::LEVELS];
+    const size_t bidCount = checksumLevels(m.bids.rbegin(), m.bids.rend(), bids);
+    const size_t askCount = checksumLevels(m.asks.begin(), m.asks.end(), asks);
+    const uint32_t checksum = BookChecksum::compute(bids, bidCount, asks, askCount);
+    data += ",\"cs\":" + QByteArray::number(static_cast<int32_t>(checksum)) + '}';
+    return envelope(stream, data);
+}
+
+void MockExchangeAdapter::klineEvents(Market& m, const QByteArray& stream, const QString& interval, qint64 nowMs,
+                                      std::vector<QByteArray>& frames) {
+    const qint64 ms = intervalMs(interval);
+    const qint64 openTime = nowMs - nowMs % ms;
+
+    auto event = [&](const Candle& c, bool closed) {
+        return envelope(stream, "{\"e\":\"kline\",\"E\":" + QByteArray::number(nowMs) + ",\"s\":\"" + m.pair
+                              + "\",\"k\":{\"t\":" + QByteArray::number(c.openTime)
+                              + ",\"T\":" + QByteArray::number(c.openTime + ms - 1)
+                              + ",\"i\":\"" + interval.toLatin1() + "\",\"o\":\"" + decimal(c.open, 2)
+                              + "\",\"c\":\"" + decimal(c.close, 2) + "\",\"h\":\"" + decimal(c.high, 2)
+                              + "\",\"l\":\"" + decimal(c.low, 2) + "\",\"v\":\"" + decimal(c.volume, 5)
+                              + "\",\"x\":" + (closed ? "true" : "false") + "}}");
+    };
+
+    Candle& c = m.candles[interval];
+    if (c.openTime != openTime) {
+        if (c.openTime != 0) frames.push_back(event(c, true));
+        c = Candle();
+        c.openTime = openTime;
+        c.open = c.high = c.low = m.mid;
+    }
+    c.close = m.mid;
+    c.high = std::max(c.high, m.mid);
+    c.low = std::min(c.low, m.mid);
+    c.volume += randomQty();
+    frames.push_back(event(c, false));
+}
+
+QByteArray MockExchangeAdapter::tickerEvent(const Market& m, const QByteArray& stream, qint64 nowMs) const {
+    const double change = m.mid - m.open24h;
+    return envelope(stream, "{\"e\":\"24hrTicker\",\"E\":" + QByteArray::number(nowMs) + ",\"s\":\"" + m.pair
+                          + "\",\"p\":\"" + decimal(change, 2) + "\",\"P\":\"" + decimal(change / m.open24h * 100.0, 3)
+                          + "\",\"c\":\"" + decimal(m.mid, 2) + "\",\"q\":\"" + decimal(m.quoteVolume24h, 2) + "\"}");
+}
+
+QByteArray MockExchangeAdapter::tradeEvent(Market& m, const QByteArray& stream, qint64 nowMs) {
+    // Buyer is maker: a seller hit the bid
+    std::bernoulli_distribution sellAggressor(0.5);
+    const bool buyerIsMaker = sellAggressor(m_rng);
+    const qint64 ticks = buyerIsMaker ? (m.bids.empty() ? std::llround(m.mid / TICK) : m.bids.rbegin()->first)
+                                      : (m.asks.empty() ? std::llround(m.mid / TICK) : m.asks.begin()->first);
+    const double qty = randomQty();
+    m.quoteVolume24h += ticks * TICK * qty;
+
+    return envelope(stream, "{\"e\":\"aggTrade\",\"E\":" + QByteArray::number(nowMs) + ",\"s\":\"" + m.pair
+                          + "\",\"a\":" + QByteArray::number(m.tradeId++) + ",\"p\":\"" + price(ticks)
+                          + "\",\"q\":\"" + decimal(qty, 5) + "\",\"T\":" + QByteArray::number(nowMs)
+                          + ",\"m\":" + (buyerIsMaker ? "true" : "false") + '}');
+}
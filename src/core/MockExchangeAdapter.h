@@ -0,0 +1,89 @@
+/**
+ * @file MockExchangeAdapter.h
+ * @brief In-process synthetic venue for offline runs and tests.
+ *
+ * Each symbol gets a deterministic random-walk market (seeded RNG): a full
+ * order book, 24h statistics and trades. REST calls are answered from that
+ * state and subscribed streams are produced on every poll, with update ids
+ * that stay consistent with the served snapshots, so depth sync, gap
+ * detection and every widget behave as they would live.
+ *
+ * Payloads use the Binance wire format, so the mock also exercises the real
+ * decoders inherited from BinanceAdapter. Depth events additionally carry
+ * a book checksum ("cs", in the BookChecksum format), so local books are
+ * verified against the simulated venue.
+ */
+
+#ifndef MOCKEXCHANGEADAPTER_H
+#define MOCKEXCHANGEADAPTER_H
+
+#include "BinanceAdapter.h"
+#include <QHash>
+#include <map>
+#include <random>
+
+/**
+ * @class MockExchangeAdapter
+ * @brief Binance-compatible market simulator behind the ExchangeAdapter interface.
+ */
+class MockExchangeAdapter : public BinanceAdapter {
+public:
+    static constexpr double TICK = 0.01;
+    static constexpr int BOOK_LEVELS = 5000;           // Per side
+    static constexpr int CHANGES_PER_STEP = 6;         // Levels touched per depth event
+    static constexpr int TICKER_EVERY_POLLS = 10;
+    static constexpr double VOLATILITY = 0.0002;       // Per-step log-return stddev
+
+    explicit MockExchangeAdapter(quint64 seed = 42);
+
+    QString name() const override { return "mock"; }
+    Transport transport() const override { return Transport::InProcess; }
+
+    QByteArray serve(const RestCall& call) override;
+    void pollStreams(const QStringList& streams, std::vector<QByteArray>& frames) override;
+
+private:
+    struct Candle {
+        qint64 openTime = 0;
+        double open = 0, high = 0, low = 0, close = 0, volume = 0;
+    };
+
+    struct Market {
+        QByteArray pair;
+        double mid = 0;
+        double open24h = 0;
+        double quoteVolume24h = 0;
+        qint64 updateId = 1;
+        qint64 tradeId = 1;
+        std::map<qint64, double> bids;      // Price in ticks -> qty
+        std::map<qint64, double> asks;
+        std::vector<std::pair<qint64, double>> lastBidChanges;
+        std::vector<std::pair<qint64, double>> lastAskChanges;
+        QHash<QString, Candle> candles;     // Interval -> live candle
+        QHash<QString, Candle> oldest;      // Interval -> oldest candle served, older pages join it
+    };
+
+    Market& market(const QByteArray& pair);
+    void step(Market& m);
+    void setLevel(Market& m, bool bid, qint64 ticks, double qty);
+    double randomQty();
+
+    QByteArray depthSnapshot(const Market& m, int limit) const;
+    QByteArray klines(Market& m, const QString& interval, int limit, qint64 endTime);
+    QByteArray ticker(const Market& m) const;
+    QByteArray exchangeInfo(const Market& m) const;
+
+    QByteArray depthEvent(const Market& m, const QByteArray& stream, qint64 nowMs) const;
+    void klineEvents(Market& m, const QByteArray& stream, const QString& interval, qint64 nowMs,
+                     std::vector<QByteArray>& frames);
+    QByteArray tickerEvent(const Market& m, const QByteArray& stream, qint64 nowMs) const;
+    QByteArray tradeEvent(Market& m, const QByteArray& stream, qint64 nowMs);
+
+    static qint64 intervalMs(const QString& interval);
+
+    std::mt19937_64 m_rng;
+    QHash<QByteArray, Market> m_markets;
+    quint64 m_polls = 0;
+};
+
+#endif // MOCKEXCHANGEADAPTER_H
@@ -0,0 +1,219 @@
+#include "RequestScheduler.h"
+#include <QDebug>
+#include <QNetworkRequest>
+#include <algorithm>
+#include <cmath>
+
+RequestScheduler::RequestScheduler(QNetworkAccessManager* manager, QObject* parent)
+    : QObject(parent)
+    , m_manager(manager)
+{
+    m_dispatchTimer = new QTimer(this);
+    m_dispatchTimer->setSingleShot(true);
+    connect(m_dispatchTimer, &QTimer::timeout, this, &RequestScheduler::dispatch);
+
+    m_refillClock.start();
+}
+
+// ==========================================
+// Submission
+// ==========================================
+
+bool RequestScheduler::submit(const Request& request) {
+    auto it = m_entries.find(request.key);
+    if (it != m_entries.end()) {
+        if (request.policy == Policy::Coalesce) {
+            ++m_coalesced;
+            return false;
+        }
+
+        Entry& entry = it.value();
+        entry.request = request;
+        entry.generation = generation(request.symbol);
+        if (entry.queued) {
+            // Superseded before it left: keep its place in the queue
+            ++m_dropped;
+            return true;
+        }
+
+        // Superseded in flight: the abort's finished() is swallowed by onReplyFinished()
+        QNetworkReply* old = entry.reply;
+        entry.reply = nullptr;
+        ++m_dropped;
+        if (old) old->abort();
+        enqueue(request.key, entry);
+        dispatch();
+        return true;
+    }
+
+    Entry& entry = m_entries[request.key];
+    entry.request = request;
+    entry.generation = generation(request.symbol);
+    enqueue(request.key, entry);
+    dispatch();
+    return true;
+}
+
+void RequestScheduler::enqueue(const QString& key, Entry& entry) {
+    entry.queued = true;
+    queue(entry.request.priority).push_back(key);
+}
+
+void RequestScheduler::invalidate(const QString& symbol) {
+    m_generations[symbol]++;
+
+    QList<QNetworkReply*> stale;
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (it->request.symbol == symbol) {
+            if (it->reply) stale.append(it->reply);
+            ++m_dropped;
+            it = m_entries.erase(it);   // Queue slots are skipped lazily in dispatch()
+        } else {
+            ++it;
+        }
+    }
+    for (QNetworkReply* reply : stale) reply->abort();
+}
+
+// ==========================================
+// Budget and dispatch
+// ==========================================
+
+void RequestScheduler::refill() {
+    const qint64 elapsedMs = m_refillClock.restart();
+    m_tokens = std::min(m_capacity, m_tokens + elapsedMs * m_capacity / 60000.0);
+}
+
+void RequestScheduler::dispatch() {
+    if (m_pauseMs > 0 && m_pauseClock.elapsed() < m_pauseMs) {
+        m_dispatchTimer->start(static_cast<int>(m_pauseMs - m_pauseClock.elapsed()));
+        return;
+    }
+    m_pauseMs = 0;
+    refill();
+
+    for (auto& keys : m_queues) {
+        while (!keys.empty()) {
+            auto it = m_entries.find(keys.front());
+            if (it == m_entries.end() || !it->queued) {
+                keys.pop_front();      // Invalidated, or already re-queued elsewhere
+                continue;
+            }
+
+            if (m_tokens < it->request.weight) {
+                // Strict priority: nothing below may overtake the head of this queue
+                const double missing = it->request.weight - m_tokens;
+                m_dispatchTimer->start(static_cast<int>(std::ceil(missing * 60000.0 / m_capacity)));
+                return;
+            }
+
+            const QString key = keys.front();
+            keys.pop_front();
+            send(key, it.value());
+        }
+    }
+}
+
+void RequestScheduler::send(const QString& key, Entry& entry) {
+    m_tokens -= entry.request.weight;
+    entry.queued = false;
+
+    QNetworkReply* reply = m_manager->get(QNetworkRequest(entry.request.url));
+    for (auto it = entry.request.properties.cbegin(); it != entry.request.properties.cend(); ++it) {
+        reply->setProperty(it.key().constData(), it.value());
+    }
+    reply->setProperty("generation", entry.generation);
+
+    entry.reply = reply;
+    entry.sent.start();
+    ++m_sent;
+
+    connect(reply, &QNetworkReply::finished, this, [this, reply, key]() { onReplyFinished(reply, key); });
+}
+
+void RequestScheduler::onReplyFinished(QNetworkReply* reply, const QString& key) {
+    auto it = m_entries.find(key);
+    const bool current = (it != m_entries.end() && it->reply == reply);
+    if (!current) {
+        // Superseded or invalidated while in flight
+        reply->deleteLater();
+        return;
+    }
+
+    if (reply->error() == QNetworkReply::NoError) {
+        const double rtt = static_cast<double>(it->sent.elapsed());
+        m_rttMs = (m_rttMs <= 0) ? rtt : m_rttMs + RTT_SMOOTHING * (rtt - m_rttMs);
+    }
+    updateWeight(reply);
+
+    const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (status == 429 || status == 418) {
+        // Rate limited (418: banned after ignoring 429s): stop everything until Retry-After
+        bool ok = false;
+        int retryAfter = reply->rawHeader("Retry-After").toInt(&ok);
+        if (!ok || retryAfter <= 0) retryAfter = DEFAULT_RETRY_AFTER_S;
+        m_pauseMs = retryAfter * 1000LL;
+        m_pauseClock.start();
+        m_tokens = 0;
+        ++m_throttled;
+        qDebug() << "REST throttled by exchange, pausing for" << retryAfter << "s";
+    }
+
+    m_entries.erase(it);
+    emit finished(reply);
+    dispatch();
+}
+
+void RequestScheduler::updateWeight(QNetworkReply* reply) {
+    // "X-MBX-USED-WEIGHT-1M" on current endpoints, "X-MBX-USED-WEIGHT" on older ones
+    QByteArray header = reply->rawHeader("X-MBX-USED-WEIGHT-1M");
+    if (header.isEmpty()) header = reply->rawHeader("X-MBX-USED-WEIGHT");
+
+    bool ok = false;
+    int weight = header.toInt(&ok);
+    if (!ok) return;
+    m_usedWeight = weight;
+
+    // The exchange's count is authoritative (other clients may share the IP)
+    refill();
+    m_tokens = std::min(m_tokens, std::max(0.0, m_capacity - weight));
+}
+
+// ==========================================
+// Metrics
+// ==========================================
+
+int RequestScheduler::pollIntervalMs(int baseMs) const {
+    double interval = std::max<double>(baseMs, m_rttMs * RTT_INTERVAL_FACTOR);
+
+    const double usage = static_cast<double>(m_usedWeight) / WEIGHT_LIMIT_PER_MINUTE;
+    if (usage > WEIGHT_BACKOFF_START) {
+        const double ramp = std::min(1.0, (usage - WEIGHT_BACKOFF_START) / (1.0 - WEIGHT_BACKOFF_START));
+        interval *= 1.0 + ramp * (WEIGHT_BACKOFF_MAX - 1.0);
+    }
+
+    return static_cast<int>(std::clamp<double>(interval, baseMs, MAX_POLL_INTERVAL_MS));
+}
+
+qint64 RequestScheduler::pauseRemainingMs() const {
+    if (m_pauseMs <= 0) return 0;
+    return std::max<qint64>(0, m_pauseMs - m_pauseClock.elapsed());
+}
+
+RequestScheduler::Metrics RequestScheduler::metrics() const {
+    Metrics m;
+    const double elapsedMs = static_cast<double>(m_refillClock.elapsed());
+    m.availableWeight = std::min(m_capacity, m_tokens + elapsedMs * m_capacity / 60000.0);
+    m.capacity = static_cast<int>(m_capacity);
+    m.usedWeight = m_usedWeight;
+    for (const Entry& entry : m_entries) {
+        if (entry.queued) m.queued[static_cast<size_t>(entry.request.priority)]++;
+        else if (entry.reply) m.inFlight++;
+    }
+    m.sent = m_sent;
+    m.coalesced = m_coalesced;
+    m.dropped = m_dropped;
+    m.throttled = m_throttled;
+    m.rttMs = m_rttMs;
+    return m;
+}
@@ -0,0 +1,151 @@
+/**
+ * @file RequestScheduler.h
+ * @brief Central REST gate: shared weight budget, priorities, in-flight
+ *        deduplication, stale-reply dropping and adaptive poll intervals.
+ *
+ * Every REST call of MarketDataHub goes through submit() with an endpoint
+ * key (e.g. "depth:BTC"). At most one request per key is queued or in flight:
+ * - Policy::Coalesce drops the new request while one is pending (polls: the
+ *   pending reply is as fresh as a new one would be)
+ * - Policy::Replace supersedes the pending request (one-shot requests whose
+ *   parameters changed): a queued one is updated, an in-flight one aborted
+ *
+ * Requests spend exchange weight from a token bucket sized below the IP
+ * limit and refilled continuously. When the budget is short, requests wait
+ * in per-priority queues and leave strictly by priority (depth before
+ * klines before tickers). The bucket is corrected from the exchange's
+ * used-weight header, and a 429/418 pauses all traffic for Retry-After.
+ *
+ * Requests are also tagged with the generation of their symbol. Dropping the
+ * last subscription of a symbol calls invalidate(), which discards its queued
+ * and in-flight requests and makes any reply still being decoded stale.
+ */
+
+#ifndef REQUESTSCHEDULER_H
+#define REQUESTSCHEDULER_H
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QObject>
+#include <QPointer>
+#include <QTimer>
+#include <QUrl>
+#include <QVariant>
+#include <array>
+#include <deque>
+
+/**
+ * @class RequestScheduler
+ * @brief Owns the dispatch of REST requests and the bookkeeping around them.
+ */
+class RequestScheduler : public QObject {
+    Q_OBJECT
+
+public:
+    enum class Policy { Coalesce, Replace };
+
+    /// Highest first. Depth keeps the book alive, tickers can wait.
+    enum class Priority { Critical, High, Normal, Low, Count };
+
+    static constexpr int WEIGHT_LIMIT_PER_MINUTE = 6000;   // Binance REQUEST_WEIGHT default
+    static constexpr double BUDGET_SHARE = 0.8;            // Headroom for other clients on the IP
+    static constexpr double RTT_SMOOTHING = 0.2;           // EWMA factor
+    static constexpr double RTT_INTERVAL_FACTOR = 2.0;     // Never poll faster than 2 RTTs
+    static constexpr double WEIGHT_BACKOFF_START = 0.5;    // Usage ratio where backoff begins
+    static constexpr double WEIGHT_BACKOFF_MAX = 4.0;      // Interval multiplier at the limit
+    static constexpr int MAX_POLL_INTERVAL_MS = 30000;
+    static constexpr int DEFAULT_RETRY_AFTER_S = 60;
+
+    struct Request {
+        QString key;                            // Dedup key, e.g. "depth:BTC"
+        QString symbol;                         // Generation scope
+        QUrl url;
+        Policy policy = Policy::Coalesce;
+        Priority priority = Priority::Normal;
+        int weight = 1;                         // Exchange request weight
+        QHash<QByteArray, QVariant> properties; // Copied onto the reply when sent
+    };
+
+    struct Metrics {
+        double availableWeight = 0;
+        int capacity = 0;
+        int usedWeight = 0;                     // Last X-MBX-USED-WEIGHT-1M
+        std::array<int, static_cast<size_t>(Priority::Count)> queued{};
+        int inFlight = 0;
+        quint64 sent = 0;
+        quint64 coalesced = 0;
+        quint64 dropped = 0;
+        quint64 throttled = 0;                  // 429/418 replies
+        double rttMs = 0;
+
+        int queuedTotal() const { int n = 0; for (int q : queued) n += q; return n; }
+    };
+
+    explicit RequestScheduler(QNetworkAccessManager* manager, QObject* parent = nullptr);
+
+    /**
+     * Queues a GET, sent as soon as the budget allows.
+     * @return false if it was coalesced into a pending request.
+     */
+    bool submit(const Request& request);
+
+    /// Discards all pending requests of @p symbol and advances its generation.
+    void invalidate(const QString& symbol);
+
+    quint64 generation(const QString& symbol) const { return m_generations.value(symbol, 0); }
+    bool isCurrent(const QString& symbol, quint64 generation) const { return this->generation(symbol) == generation; }
+
+    /// @p baseMs stretched by the measured RTT and by weight usage.
+    int pollIntervalMs(int baseMs) const;
+
+    Metrics metrics() const;
+
+    /// Time left before an exchange-imposed pause (429/418) ends; 0 when not paused.
+    qint64 pauseRemainingMs() const;
+
+signals:
+    /// A current reply is ready. The receiver owns it and must deleteLater() it.
+    void finished(QNetworkReply* reply);
+
+private:
+    struct Entry {
+        Request request;
+        quint64 generation = 0;
+        bool queued = false;
+        QPointer<QNetworkReply> reply;
+        QElapsedTimer sent;
+    };
+
+    void enqueue(const QString& key, Entry& entry);
+    void dispatch();
+    void send(const QString& key, Entry& entry);
+    void refill();
+    void onReplyFinished(QNetworkReply* reply, const QString& key);
+    void updateWeight(QNetworkReply* reply);
+
+    std::deque<QString>& queue(Priority priority) { return m_queues[static_cast<size_t>(priority)]; }
+
+    QNetworkAccessManager* m_manager;
+    QTimer* m_dispatchTimer;
+    QHash<QString, Entry> m_entries;            // Endpoint key -> queued or in-flight request
+    std::array<std::deque<QString>, static_cast<size_t>(Priority::Count)> m_queues;
+    QHash<QString, quint64> m_generations;      // Symbol -> generation
+
+    // Token bucket, in exchange weight units
+    const double m_capacity = WEIGHT_LIMIT_PER_MINUTE * BUDGET_SHARE;
+    double m_tokens = WEIGHT_LIMIT_PER_MINUTE * BUDGET_SHARE;
+    QElapsedTimer m_refillClock;
+    QElapsedTimer m_pauseClock;
+    qint64 m_pauseMs = 0;                       // Throttled by the exchange until m_pauseClock passes this
+
+    double m_rttMs = 0;
+    int m_usedWeight = 0;
+    quint64 m_sent = 0;
+    quint64 m_coalesced = 0;
+    quint64 m_dropped = 0;
+    quint64 m_throttled = 0;
+};
+
+#endif // REQUESTSCHEDULER_H
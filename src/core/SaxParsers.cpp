@@ -0,0 +1,415 @@
+#include "SaxParsers.h"
+#include "nlohmann/json.hpp"
+#include <charconv>
+#include <string>
+
+namespace {
+
+using json = nlohmann::json;
+
+bool toDouble(const std::string& text, double& value) {
+    const char* first = text.data();
+    const char* last = first + text.size();
+    auto result = std::from_chars(first, last, value);
+    return result.ec == std::errc() && result.ptr == last;
+}
+
+/**
+ * Common SAX plumbing: every callback the concept requires, defaulting to
+ * "accept and ignore". Handlers override the ones they care about.
+ */
+struct SaxBase {
+    using number_integer_t = json::number_integer_t;
+    using number_unsigned_t = json::number_unsigned_t;
+    using number_float_t = json::number_float_t;
+    using string_t = json::string_t;
+    using binary_t = json::binary_t;
+
+    int depth = 0;
+
+    bool null() { return true; }
+    bool boolean(bool) { return true; }
+    bool number_integer(number_integer_t) { return true; }
+    bool number_unsigned(number_unsigned_t) { return true; }
+    bool number_float(number_float_t, const string_t&) { return true; }
+    bool string(string_t&) { return true; }
+    bool binary(binary_t&) { return false; }
+    bool start_object(std::size_t) { ++depth; return true; }
+    bool key(string_t&) { return true; }
+    bool end_object() { --depth; return true; }
+    bool start_array(std::size_t) { ++depth; return true; }
+    bool end_array() { --depth; return true; }
+    bool parse_error(std::size_t, const std::string&, const json::exception&) { return false; }
+};
+
+/**
+ * Collects [["price","qty"],..] arrays into BookLevel vectors.
+ * A side starts when an array opens right after a bids/asks key.
+ * Levels are parsed straight from the decimal text, without a double.
+ */
+struct LevelCollector {
+    std::vector<BookLevel>* side = nullptr;
+    int sideDepth = 0;
+    int field = 0;
+    Price price;
+
+    bool inLevel(int depth) const { return side && depth == sideDepth + 1; }
+
+    // Returns true if the array was consumed as a side or a level
+    bool startArray(int depth, std::vector<BookLevel>* pendingSide) {
+        if (!side && pendingSide) {
+            side = pendingSide;
+            sideDepth = depth;
+            return true;
+        }
+        if (inLevel(depth)) {
+            field = 0;
+            return true;
+        }
+        return false;
+    }
+
+    void endArray(int depth) {
+        if (side && depth == sideDepth) side = nullptr;
+    }
+
+    bool value(const std::string& text) {
+        if (field == 0) {
+            if (!Price::parse(text, price)) return false;
+        } else if (field == 1) {
+            Qty qty;
+            if (!Qty::parse(text, qty)) return false;
+            side->push_back({price, qty});
+        }
+        ++field;
+        return true;
+    }
+};
+
+// ==========================================
+// REST depth snapshot
+// ==========================================
+
+struct DepthSnapshotSax : SaxBase {
+    DepthSnapshot& out;
+    LevelCollector levels;
+    std::vector<BookLevel>* pendingSide = nullptr;
+    bool lastUpdateIdKey = false;
+
+    explicit DepthSnapshotSax(DepthSnapshot& o) : out(o) {}
+
+    bool key(string_t& k) {
+        lastUpdateIdKey = (k == "lastUpdateId");
+        pendingSide = (k == "bids") ? &out.bids : (k == "asks") ? &out.asks : nullptr;
+        return true;
+    }
+    bool number_unsigned(number_unsigned_t v) {
+        if (lastUpdateIdKey) out.lastUpdateId = static_cast<int64_t>(v);
+        lastUpdateIdKey = false;
+        return true;
+    }
+    bool string(string_t& v) {
+        if (levels.inLevel(depth)) return levels.value(v);
+        return true;
+    }
+    bool start_array(std::size_t) {
+        ++depth;
+        levels.startArray(depth, pendingSide);
+        pendingSide = nullptr;
+        return true;
+    }
+    bool end_array() {
+        levels.endArray(depth);
+        --depth;
+        return true;
+    }
+};
+
+// ==========================================
+// REST klines
+// ==========================================
+
+struct KlinesSax : SaxBase {
+    std::vector<Candle>& out;
+    int field = 0;
+
+    explicit KlinesSax(std::vector<Candle>& o) : out(o) {}
+
+    bool start_array(std::size_t) {
+        ++depth;
+        if (depth == 2) {
+            out.emplace_back();
+            field = 0;
+        }
+        return true;
+    }
+    bool number_unsigned(number_unsigned_t v) {
+        if (depth == 2 && field == 0) out.back().openTime = static_cast<int64_t>(v);
+        if (depth == 2) ++field;
+        return true;
+    }
+    bool number_integer(number_integer_t v) {
+        if (depth == 2 && field == 0) out.back().openTime = v;
+        if (depth == 2) ++field;
+        return true;
+    }
+    bool string(string_t& v) {
+        if (depth != 2) return true;
+        Candle& c = out.back();
+        bool ok = true;
+        switch (field) {
+        case 1: ok = toDouble(v, c.open); break;
+        case 2: ok = toDouble(v, c.high); break;
+        case 3: ok = toDouble(v, c.low); break;
+        case 4: ok = toDouble(v, c.close); break;
+        case 5: ok = toDouble(v, c.volume); break;
+        default: break;
+        }
+        ++field;
+        return ok;
+    }
+    bool number_float(number_float_t, const string_t&) {
+        if (depth == 2) ++field;
+        return true;
+    }
+};
+
+// ==========================================
+// REST 24h ticker
+// ==========================================
+
+struct TickerSax : SaxBase {
+    enum class Key { None, Symbol, PriceChange, PriceChangePercent, LastPrice, QuoteVolume };
+
+    TickerStats& out;
+    ShortText& symbol;
+    Key current = Key::None;
+
+    TickerSax(TickerStats& o, ShortText& s) : out(o), symbol(s) {}
+
+    bool key(string_t& k) {
+        if (k == "symbol") current = Key::Symbol;
+        else if (k == "priceChange") current = Key::PriceChange;
+        else if (k == "priceChangePercent") current = Key::PriceChangePercent;
+        else if (k == "lastPrice") current = Key::LastPrice;
+        else if (k == "quoteVolume") current = Key::QuoteVolume;
+        else current = Key::None;
+        return true;
+    }
+    bool string(string_t& v) {
+        Key k = current;
+        current = Key::None;
+        switch (k) {
+        case Key::Symbol:             symbol.assign(v); return true;
+        case Key::PriceChange:        return toDouble(v, out.priceChange);
+        case Key::PriceChangePercent: return toDouble(v, out.priceChangePercent);
+        case Key::LastPrice:          return toDouble(v, out.lastPrice);
+        case Key::QuoteVolume:        return toDouble(v, out.quoteVolume);
+        case Key::None:               return true;
+        }
+        return true;
+    }
+};
+
+// ==========================================
+// WebSocket events
+// ==========================================
+
+/**
+ * Binance events use single-letter keys whose meaning depends on the event
+ * type (e.g. "p" is the price change of a ticker but the price of a trade),
+ * so scalars are captured by key and interpreted once the event is complete.
+ * Kline fields live in the nested "k" object. The only longer key is the
+ * optional depth checksum "cs", mapped to a character no event uses.
+ */
+struct StreamSax : SaxBase {
+    static constexpr char CHECKSUM_KEY = '#';
+
+    StreamEvent& out;
+    LevelCollector levels;
+    char pendingKey = 0;
+    bool inKline = false;
+    int klineDepth = 0;
+
+    // Outer-scope captures
+    double p = 0, P = 0, c = 0, q = 0;
+    int64_t U = 0, u = 0, a = 0, T = 0, cs = 0;
+    bool m = false, hasCs = false;
+
+    explicit StreamSax(StreamEvent& o) : out(o) {}
+
+    bool key(string_t& k) {
+        pendingKey = (k.size() == 1) ? k[0] : (k == "cs" ? CHECKSUM_KEY : 0);
+        return true;
+    }
+    bool boolean(bool v) {
+        if (inKline && pendingKey == 'x') out.klineClosed = v;
+        else if (!inKline && pendingKey == 'm') m = v;
+        pendingKey = 0;
+        return true;
+    }
+    bool number_unsigned(number_unsigned_t v) {
+        return number_integer(static_cast<number_integer_t>(v));
+    }
+    bool number_integer(number_integer_t v) {
+        if (inKline) {
+            if (pendingKey == 't') out.kline.openTime = v;
+        } else {
+            switch (pendingKey) {
+            case 'E': out.eventTimeMs = v; break;
+            case 'U': U = v; break;
+            case 'u': u = v; break;
+            case 'a': a = v; break;
+            case 'T': T = v; break;
+            case CHECKSUM_KEY: cs = v; hasCs = true; break;
+            default: break;
+            }
+        }
+        pendingKey = 0;
+        return true;
+    }
+    bool string(string_t& v) {
+        if (levels.inLevel(depth)) return levels.value(v);
+
+        char k = pendingKey;
+        pendingKey = 0;
+        if (inKline) {
+            switch (k) {
+            case 'i': out.klineInterval.assign(v); return true;
+            case 'o': return toDouble(v, out.kline.open);
+            case 'h': return toDouble(v, out.kline.high);
+            case 'l': return toDouble(v, out.kline.low);
+            case 'c': return toDouble(v, out.kline.close);
+            case 'v': return toDouble(v, out.kline.volume);
+            default:  return true;
+            }
+        }
+        switch (k) {
+        case 'e':
+            if (v == "depthUpdate") out.type = StreamEvent::Type::Depth;
+            else if (v == "kline") out.type = StreamEvent::Type::Kline;
+            else if (v == "24hrTicker") out.type = StreamEvent::Type::Ticker;
+            else if (v == "aggTrade") out.type = StreamEvent::Type::Trade;
+            return true;
+        case 's': out.symbol.assign(v); return true;
+        case 'p': return toDouble(v, p);
+        case 'P': return toDouble(v, P);
+        case 'c': return toDouble(v, c);
+        case 'q': return toDouble(v, q);
+        default:  return true;
+        }
+    }
+    bool start_object(std::size_t) {
+        ++depth;
+        if (pendingKey == 'k' && !inKline) {
+            inKline = true;
+            klineDepth = depth;
+        }
+        pendingKey = 0;
+        return true;
+    }
+    bool end_object() {
+        if (inKline && depth == klineDepth) inKline = false;
+        --depth;
+        return true;
+    }
+    bool start_array(std::size_t) {
+        ++depth;
+        std::vector<BookLevel>* pendingSide = nullptr;
+        if (!inKline && pendingKey == 'b') pendingSide = &out.depth.bids;
+        else if (!inKline && pendingKey == 'a') pendingSide = &out.depth.asks;
+        levels.startArray(depth, pendingSide);
+        pendingKey = 0;
+        return true;
+    }
+    bool end_array() {
+        levels.endArray(depth);
+        --depth;
+        return true;
+    }
+    bool null() {
+        pendingKey = 0;
+        return true;
+    }
+
+    void finish() {
+        switch (out.type) {
+        case StreamEvent::Type::Depth:
+            out.depth.firstUpdateId = U;
+            out.depth.lastUpdateId = u;
+            // Sent as a signed 32-bit integer
+            out.depth.hasChecksum = hasCs;
+            out.depth.checksum = static_cast<uint32_t>(cs);
+            break;
+        case StreamEvent::Type::Ticker:
+            out.ticker.lastPrice = c;
+            out.ticker.priceChange = p;
+            out.ticker.priceChangePercent = P;
+            out.ticker.quoteVolume = q;
+            break;
+        case StreamEvent::Type::Trade:
+            out.trade.tradeId = a;
+            out.trade.timeMs = T;
+            out.trade.price = p;
+            out.trade.qty = q;
+            out.trade.buyerIsMaker = m;
+            break;
+        case StreamEvent::Type::Kline:
+        case StreamEvent::Type::None:
+            break;
+        }
+    }
+};
+
+template <typename Handler>
+bool runSax(std::string_view json, Handler& handler) {
+    return json::sax_parse(json.data(), json.data() + json.size(), &handler);
+}
+
+} // namespace
+
+bool MarketSaxParser::parseDepthSnapshot(std::string_view json, DepthSnapshot& out) {
+    out.lastUpdateId = 0;
+    out.bids.clear();
+    out.asks.clear();
+
+    DepthSnapshotSax handler(out);
+    return runSax(json, handler);
+}
+
+bool MarketSaxParser::parseKlines(std::string_view json, std::vector<Candle>& out) {
+    out.clear();
+
+    KlinesSax handler(out);
+    return runSax(json, handler);
+}
+
+bool MarketSaxParser::parseTicker(std::string_view json, TickerStats& out, ShortText& symbol) {
+    out = TickerStats();
+    symbol.clear();
+
+    TickerSax handler(out, symbol);
+    return runSax(json, handler);
+}
+
+bool MarketSaxParser::parseStreamEvent(std::string_view json, StreamEvent& out) {
+    out.type = StreamEvent::Type::None;
+    out.symbol.clear();
+    out.eventTimeMs = 0;
+    out.depth.firstUpdateId = 0;
+    out.depth.lastUpdateId = 0;
+    out.depth.hasChecksum = false;
+    out.depth.checksum = 0;
+    out.depth.bids.clear();
+    out.depth.asks.clear();
+    out.kline = Candle();
+    out.klineInterval.clear();
+    out.klineClosed = false;
+    out.ticker = TickerStats();
+    out.trade = TradePrint();
+
+    StreamSax handler(out);
+    if (!runSax(json, handler)) return false;
+    handler.finish();
+    return true;
+}
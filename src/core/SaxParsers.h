@@ -0,0 +1,42 @@
+/**
+ * @file SaxParsers.h
+ * @brief Streaming (SAX) parsers for exchange depth, kline and ticker payloads.
+ *
+ * Built on the vendored nlohmann/json SAX interface: no DOM is built, price
+ * and quantity strings are converted in place with std::from_chars and
+ * written straight into the caller's level/candle arrays. Output containers
+ * are cleared but keep their capacity, so reusing them makes steady-state
+ * parsing free of per-level heap allocations.
+ */
+
+#ifndef SAXPARSERS_H
+#define SAXPARSERS_H
+
+#include "MarketTypes.h"
+#include <string_view>
+#include <vector>
+
+/**
+ * @class MarketSaxParser
+ * @brief Stateless entry points, safe to call concurrently from worker threads.
+ */
+class MarketSaxParser {
+public:
+    /// REST `/api/v3/depth`: {"lastUpdateId":..,"bids":[["p","q"],..],"asks":[..]}
+    static bool parseDepthSnapshot(std::string_view json, DepthSnapshot& out);
+
+    /// REST `/api/v3/klines`: [[openTime,"o","h","l","c","v",...],..]
+    static bool parseKlines(std::string_view json, std::vector<Candle>& out);
+
+    /// REST `/api/v3/ticker/24hr`: {"symbol":..,"priceChange":..,"lastPrice":..,..}
+    static bool parseTicker(std::string_view json, TickerStats& out, ShortText& symbol);
+
+    /**
+     * WebSocket event, raw (`/ws`) or wrapped in the combined-stream envelope
+     * (`/stream`). Handles depthUpdate, kline, 24hrTicker and aggTrade;
+     * anything else (e.g. SUBSCRIBE acks) yields StreamEvent::Type::None.
+     */
+    static bool parseStreamEvent(std::string_view json, StreamEvent& out);
+};
+
+#endif // SAXPARSERS_H
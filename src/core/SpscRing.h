@@ -0,0 +1,113 @@
+/**
+ * @file SpscRing.h
+ * @brief Bounded lock-free single-producer / single-consumer ring buffer.
+ *
+ * One thread pushes, one other thread pops; neither ever blocks or takes a
+ * lock. Head and tail are monotonically increasing counters on their own
+ * cache lines, and each side keeps a private copy of the other side's
+ * counter, so the shared atomics are only re-read when the ring looks
+ * full (producer) or empty (consumer). Slots are preallocated: steady-state
+ * pushes and pops do not allocate as long as T itself does not.
+ *
+ * When the consumer falls behind, push() fails and the element is counted
+ * as dropped instead of stalling the producer.
+ */
+
+#ifndef SPSCRING_H
+#define SPSCRING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * @class SpscRing
+ * @brief Fixed-capacity FIFO between exactly one producer and one consumer thread.
+ */
+template <typename T>
+class SpscRing {
+public:
+    /// @p capacity is rounded up to a power of two.
+    explicit SpscRing(size_t capacity) {
+        size_t size = 1;
+        while (size < capacity) size <<= 1;
+        m_slots.resize(size);
+        m_mask = size - 1;
+    }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    size_t capacity() const { return m_slots.size(); }
+
+    // Producer thread only --------------------------------------------------
+
+    /// @return false (and counts a drop) if the ring is full.
+    bool push(T value) {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_cachedTail == m_slots.size()) {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+            if (head - m_cachedTail == m_slots.size()) {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+        }
+        m_slots[head & m_mask] = std::move(value);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer thread only --------------------------------------------------
+
+    bool pop(T& out) {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail == m_cachedHead) {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+            if (tail == m_cachedHead) return false;
+        }
+        out = std::move(m_slots[tail & m_mask]);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Pops everything available when called (at most @p max), handing each
+     * element to @p fn, and releases the slots once at the end.
+     * @return number of elements popped.
+     */
+    template <typename Fn>
+    size_t drain(Fn&& fn, size_t max = SIZE_MAX) {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        m_cachedHead = m_head.load(std::memory_order_acquire);
+        size_t count = m_cachedHead - tail;
+        if (count > max) count = max;
+        for (size_t i = 0; i < count; ++i) fn(std::move(m_slots[(tail + i) & m_mask]));
+        if (count) m_tail.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    // Any thread ------------------------------------------------------------
+
+    /// Elements in the ring; exact only when both sides are idle.
+    size_t sizeApprox() const {
+        return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire);
+    }
+
+    uint64_t dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr size_t CACHE_LINE = 64;
+
+    std::vector<T> m_slots;
+    size_t m_mask = 0;
+
+    alignas(CACHE_LINE) std::atomic<size_t> m_head{0};     // Next slot to write
+    size_t m_cachedTail = 0;                                // Producer's view of m_tail
+    alignas(CACHE_LINE) std::atomic<size_t> m_tail{0};     // Next slot to read
+    size_t m_cachedHead = 0;                                // Consumer's view of m_head
+    alignas(CACHE_LINE) std::atomic<uint64_t> m_dropped{0};
+};
+
+#endif // SPSCRING_H
@@ -0,0 +1,91 @@
+#include "SymbolRegistry.h"
+#include <QCoreApplication>
+#include <QDebug>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+namespace {
+
+template <typename T>
+bool parseDecimal(const QJsonValue& value, T& out) {
+    const QByteArray text = value.toString().toLatin1();
+    return T::parse(std::string_view(text.constData(), static_cast<size_t>(text.size())), out);
+}
+
+} // namespace
+
+SymbolRegistry* SymbolRegistry::instance() {
+    static SymbolRegistry* registry = new SymbolRegistry(QCoreApplication::instance());
+    return registry;
+}
+
+SymbolRegistry::SymbolRegistry(QObject* parent)
+    : QObject(parent)
+{
+    if (!loadFile(BUNDLED_FILE)) {
+        qDebug() << "Bundled symbol rules unavailable, using defaults until exchangeInfo arrives";
+    }
+}
+
+SymbolInfo SymbolRegistry::info(const QString& symbol) const {
+    auto it = m_symbols.constFind(symbol);
+    if (it != m_symbols.constEnd()) return it.value();
+
+    SymbolInfo defaults;
+    defaults.symbol = symbol;
+    defaults.exchangeSymbol = symbol.toUpper() + "USDT";
+    return defaults;
+}
+
+void SymbolRegistry::update(const std::vector<SymbolInfo>& symbols) {
+    if (symbols.empty()) return;
+    for (const SymbolInfo& info : symbols) {
+        m_symbols.insert(info.symbol, info);
+    }
+    emit symbolsUpdated();
+}
+
+bool SymbolRegistry::loadFile(const QString& path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) return false;
+
+    std::vector<SymbolInfo> symbols;
+    if (!parseExchangeInfo(file.readAll(), symbols)) return false;
+    update(symbols);
+    return true;
+}
+
+bool SymbolRegistry::parseExchangeInfo(const QByteArray& payload, std::vector<SymbolInfo>& out) {
+    QJsonDocument doc = QJsonDocument::fromJson(payload);
+    if (!doc.isObject() || !doc.object()["symbols"].isArray()) return false;
+
+    for (const QJsonValue& val : doc.object()["symbols"].toArray()) {
+        QJsonObject obj = val.toObject();
+        if (obj["quoteAsset"].toString() != "USDT") continue;
+
+        SymbolInfo info;
+        info.symbol = obj["baseAsset"].toString();
+        info.exchangeSymbol = obj["symbol"].toString();
+        info.known = true;
+
+        for (const QJsonValue& filterVal : obj["filters"].toArray()) {
+            QJsonObject filter = filterVal.toObject();
+            const QString type = filter["filterType"].toString();
+            if (type == "PRICE_FILTER") {
+                parseDecimal(filter["tickSize"], info.tickSize);
+            } else if (type == "LOT_SIZE") {
+                parseDecimal(filter["stepSize"], info.stepSize);
+                parseDecimal(filter["minQty"], info.minQty);
+            } else if (type == "NOTIONAL" || type == "MIN_NOTIONAL") {
+                info.minNotional = filter["minNotional"].toString().toDouble();
+            }
+        }
+
+        // A zero tick or step would disable rounding entirely
+        if (!info.tickSize.isPositive() || !info.stepSize.isPositive()) continue;
+        out.push_back(info);
+    }
+    return true;
+}
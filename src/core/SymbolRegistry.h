@@ -0,0 +1,76 @@
+/**
+ * @file SymbolRegistry.h
+ * @brief Per-symbol trading rules (tick size, step size, minimums).
+ *
+ * Rules come from the exchange's `/api/v3/exchangeInfo` endpoint. A copy of
+ * that response for the supported pairs is bundled as a resource
+ * (data/symbols.json) so prices can be rounded correctly before the network
+ * is up, or when running offline. MarketDataHub refreshes the entries from
+ * the live endpoint the first time a symbol is subscribed.
+ */
+
+#ifndef SYMBOLREGISTRY_H
+#define SYMBOLREGISTRY_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QObject>
+#include <QString>
+#include <vector>
+#include "FixedPoint.h"
+
+/**
+ * @struct SymbolInfo
+ * @brief Trading rules of one pair, keyed by application symbol ("BTC").
+ */
+struct SymbolInfo {
+    QString symbol;                                 // Application symbol, e.g. "BTC"
+    QString exchangeSymbol;                         // Exchange pair, e.g. "BTCUSDT"
+    Price tickSize = Price::fromRaw(1000000);       // 0.01
+    Qty stepSize = Qty::fromRaw(1000);              // 0.00001
+    Qty minQty = Qty::fromRaw(1000);
+    double minNotional = 0;
+    bool known = false;                             // false: defaults, symbol not listed
+
+    int priceDecimals() const { return tickSize.decimals(); }
+    int qtyDecimals() const { return stepSize.decimals(); }
+};
+
+/**
+ * @class SymbolRegistry
+ * @brief Application-wide cache of SymbolInfo.
+ */
+class SymbolRegistry : public QObject {
+    Q_OBJECT
+
+public:
+    static constexpr const char* BUNDLED_FILE = ":/data/symbols.json";
+
+    static SymbolRegistry* instance();
+
+    /// Rules for @p symbol, or conservative defaults if it is unknown.
+    SymbolInfo info(const QString& symbol) const;
+    bool contains(const QString& symbol) const { return m_symbols.contains(symbol); }
+
+    /// Merges entries (e.g. freshly decoded exchangeInfo) into the cache.
+    void update(const std::vector<SymbolInfo>& symbols);
+
+    /// Loads a saved exchangeInfo response.
+    bool loadFile(const QString& path);
+
+    /**
+     * Extracts the USDT pairs of an exchangeInfo payload. Thread-safe,
+     * called from decoder workers.
+     */
+    static bool parseExchangeInfo(const QByteArray& payload, std::vector<SymbolInfo>& out);
+
+signals:
+    void symbolsUpdated();
+
+private:
+    explicit SymbolRegistry(QObject* parent = nullptr);
+
+    QHash<QString, SymbolInfo> m_symbols;
+};
+
+#endif // SYMBOLREGISTRY_H
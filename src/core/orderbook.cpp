@@ -1,14 +1,9 @@
 #include "orderbook.h"
+#include "MarketDataHub.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QHeaderView>
-#include <QDebug>
-#include <QNetworkRequest>
-#include <QUrl>
-#include <QTableWidgetItem>
-#include <algorithm>
-#include <cmath>
-#include <map>
+#include <QScrollBar>
 
 OrderBook::OrderBook(QWidget *parent)
     : QWidget(parent)
@@ -16,19 +11,27 @@ OrderBook::OrderBook(QWidget *parent)
 {
     setupUi();
 
-    m_networkManager = new QNetworkAccessManager(this);
-    connect(m_networkManager, &QNetworkAccessManager::finished, this, &OrderBook::onHttpResponse);
-
-    m_pollTimer = new QTimer(this);
-    m_pollTimer->setInterval(1000);
-    connect(m_pollTimer, &QTimer::timeout, this, &OrderBook::fetchOrderBook);
-    m_pollTimer->start();
-
-    fetchOrderBook();
+    m_renderTimer = new QTimer(this);
+    m_renderTimer->setSingleShot(true);
+    m_renderTimer->setInterval(RENDER_INTERVAL_MS);
+    connect(m_renderTimer, &QTimer::timeout, this, &OrderBook::renderBook);
+
+    SymbolRegistry* registry = SymbolRegistry::instance();
+    m_symbolInfo = registry->info(m_currentSymbol);
+    applyGrouping();
+    connect(registry, &SymbolRegistry::symbolsUpdated, this, [this]() {
+        m_symbolInfo = SymbolRegistry::instance()->info(m_currentSymbol);
+        applyGrouping();
+    });
+
+    MarketDataHub* hub = MarketDataHub::instance();
+    connect(hub, &MarketDataHub::bookUpdated, this, &OrderBook::onBookUpdated);
+    connect(hub, &MarketDataHub::bookMetricsUpdated, this, &OrderBook::onBookMetrics);
+    hub->subscribe(MarketDataHub::Stream::Depth, m_currentSymbol);
 }
 
 OrderBook::~OrderBook() {
-    m_pollTimer->stop();
+    MarketDataHub::instance()->unsubscribe(MarketDataHub::Stream::Depth, m_currentSymbol);
 }
 
 void OrderBook::setupUi() {
@@ -36,9 +39,44 @@ void OrderBook::setupUi() {
     mainLayout->setContentsMargins(0, 0, 0, 0);
     mainLayout->setSpacing(0);
 
-    asksTable = new QTableWidget(this);
-    asksTable->setColumnCount(3);
-    asksTable->setHorizontalHeaderLabels({"Price", "Amount", "Total"});
+    // Header: price grouping selector
+    QWidget* header = new QWidget(this);
+    header->setStyleSheet("background-color: #161616;");
+    QHBoxLayout* headerLayout = new QHBoxLayout(header);
+    headerLayout->setContentsMargins(8, 4, 8, 4);
+    headerLayout->addStretch();
+    QLabel* groupLabel = new QLabel("Group", header);
+    groupLabel->setStyleSheet("color: #848e9c; font-size: 11px;");
+    headerLayout->addWidget(groupLabel);
+
+    groupingCombo = new QComboBox(header);
+    for (const char* step : GROUPING_STEPS) groupingCombo->addItem(step);
+    groupingCombo->setStyleSheet(
+        "QComboBox { background-color: #202020; color: #c3c5cb; border: 1px solid #333; padding: 1px 6px; font-size: 11px; }"
+    );
+    connect(groupingCombo, &QComboBox::currentIndexChanged, this, [this]() {
+        applyGrouping();
+        renderBook();
+    });
+    headerLayout->addWidget(groupingCombo);
+
+    QLabel* depthLabel = new QLabel("Depth", header);
+    depthLabel->setStyleSheet("color: #848e9c; font-size: 11px;");
+    headerLayout->addWidget(depthLabel);
+
+    depthCombo = new QComboBox(header);
+    for (int depth : LADDER_DEPTHS) depthCombo->addItem(QString::number(depth), depth);
+    depthCombo->setStyleSheet(groupingCombo->styleSheet());
+    connect(depthCombo, &QComboBox::currentIndexChanged, this, [this]() {
+        m_ladderDepth = depthCombo->currentData().toInt();
+        renderBook();
+    });
+    headerLayout->addWidget(depthCombo);
+    mainLayout->addWidget(header, 0);
+
+    m_asksModel = new DepthLadderModel(BookSide::Ask, this);
+    asksTable = new QTableView(this);
+    asksTable->setModel(m_asksModel);
 
     asksTable->horizontalHeader()->setVisible(true);
     asksTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
@@ -47,14 +85,16 @@ void OrderBook::setupUi() {
         "QHeaderView::section { background-color: #161616; color: #848e9c; border: none; font-weight: bold; font-size: 11px; padding: 4px; }"
     );
 
-    asksTable->verticalHeader()->setVisible(false);
-    asksTable->verticalHeader()->setSectionResizeMode(QHeaderView::Stretch);
-    asksTable->setShowGrid(false);
-    asksTable->setSelectionMode(QAbstractItemView::NoSelection);
-    asksTable->setFocusPolicy(Qt::NoFocus);
-    asksTable->setStyleSheet("background-color: #161616; border: none;");
-    asksTable->setItemDelegate(new DepthDelegate(asksTable));
-    asksTable->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
+    setupLadder(asksTable);
+
+    // Rows are added above the viewport as the book deepens: stay on the best ask
+    QScrollBar* asksScroll = asksTable->verticalScrollBar();
+    connect(asksScroll, &QScrollBar::valueChanged, this, [this, asksScroll](int value) {
+        m_asksPinned = value == asksScroll->maximum();
+    });
+    connect(asksScroll, &QScrollBar::rangeChanged, this, [this, asksScroll](int, int max) {
+        if (m_asksPinned) asksScroll->setValue(max);
+    });
     mainLayout->addWidget(asksTable, 1);
 
     spreadLabel = new QLabel(this);
@@ -62,289 +102,121 @@ void OrderBook::setupUi() {
     spreadLabel->setStyleSheet("color: #aaa; font-size: 10pt; padding: 5px; background-color: #202020; font-family: Consolas, monospace;");
     mainLayout->addWidget(spreadLabel, 0);
 
-    bidsTable = new QTableWidget(this);
-    bidsTable->setColumnCount(3);
+    m_bidsModel = new DepthLadderModel(BookSide::Bid, this);
+    bidsTable = new QTableView(this);
+    bidsTable->setModel(m_bidsModel);
     bidsTable->horizontalHeader()->setVisible(false);
-    bidsTable->verticalHeader()->setVisible(false);
-    bidsTable->verticalHeader()->setSectionResizeMode(QHeaderView::Stretch);
-    bidsTable->setShowGrid(false);
-    bidsTable->setSelectionMode(QAbstractItemView::NoSelection);
-    bidsTable->setFocusPolicy(Qt::NoFocus);
-    bidsTable->setStyleSheet("background-color: #161616; border: none;");
-    bidsTable->setItemDelegate(new DepthDelegate(bidsTable));
     bidsTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
-    bidsTable->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
+    setupLadder(bidsTable);
     mainLayout->addWidget(bidsTable, 1);
 }
 
-QString OrderBook::buildRequestUrl() {
-    QString symbol = m_currentSymbol.toUpper() + "USDT";
-    return QString("https://api.binance.com/api/v3/depth?symbol=%1&limit=100").arg(symbol);
-}
-
-void OrderBook::fetchOrderBook() {
-    QString url = buildRequestUrl();
-    qDebug() << "Fetching orderbook:" << url;
-    QNetworkRequest request{QUrl(url)};
-    m_networkManager->get(request);
-}
-
-void OrderBook::onHttpResponse(QNetworkReply* reply) {
-    reply->deleteLater();
-
-    if (reply->error() != QNetworkReply::NoError) {
-        qDebug() << "HTTP error:" << reply->errorString();
-        return;
-    }
-
-    int statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
-    if (statusCode != 200) {
-        qDebug() << "HTTP status:" << statusCode;
-        return;
-    }
-
-    QByteArray data = reply->readAll();
-    QJsonDocument doc = QJsonDocument::fromJson(data);
-    if (doc.isNull() || !doc.isObject()) return;
-
-    QJsonObject obj = doc.object();
-    if (!obj.contains("asks") || !obj["asks"].isArray() ||
-        !obj.contains("bids") || !obj["bids"].isArray()) {
-        return;
-    }
-
-    processDepthData(obj);
+void OrderBook::setupLadder(QTableView* table) {
+    // Fixed row heights: the view maps the viewport to rows arithmetically and
+    // paints only those, where Stretch would lay out every row on each change
+    table->verticalHeader()->setVisible(false);
+    table->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    table->verticalHeader()->setDefaultSectionSize(LADDER_ROW_HEIGHT);
+    table->setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+    table->setVerticalScrollBarPolicy(Qt::ScrollBarAsNeeded);
+    table->setShowGrid(false);
+    table->setSelectionMode(QAbstractItemView::NoSelection);
+    table->setFocusPolicy(Qt::NoFocus);
+    table->setStyleSheet("background-color: #161616; border: none;");
+    table->setItemDelegate(new DepthDelegate(table));
+    table->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
 }
 
 void OrderBook::setSymbol(const QString& symbol) {
     if (m_currentSymbol != symbol) {
+        MarketDataHub* hub = MarketDataHub::instance();
+        hub->subscribe(MarketDataHub::Stream::Depth, symbol);
+        hub->unsubscribe(MarketDataHub::Stream::Depth, m_currentSymbol);
         m_currentSymbol = symbol;
-        fetchOrderBook();
+        m_symbolInfo = SymbolRegistry::instance()->info(symbol);
+        m_book.clear();
+        m_aggregator.clear();
+        m_bookReady = false;
+        applyGrouping();
     }
 }
 
-void OrderBook::processDepthData(const QJsonObject& json) {
-    double maxTotal = 0;
-
-    // Parse raw ask levels
-    if (json.contains("asks") && json["asks"].isArray()) {
-        QJsonArray asksArray = json["asks"].toArray();
-        std::vector<Level> rawAsks;
-        rawAsks.reserve(asksArray.size());
-
-        for (const QJsonValue& val : asksArray) {
-            QJsonArray entry = val.toArray();
-            if (entry.size() >= 2) {
-                bool priceOk = false, qtyOk = false;
-                double price = entry[0].toString().toDouble(&priceOk);
-                double qty = entry[1].toString().toDouble(&qtyOk);
-                if (priceOk && qtyOk && price > 0 && qty >= 0) {
-                    rawAsks.push_back({price, qty});
-                }
-            }
-        }
-
-        std::vector<Level> grouped = aggregateLevels(rawAsks, false);
-
-        // Take top ORDERBOOK_DEPTH levels (lowest asks = best)
-        if ((int)grouped.size() > ORDERBOOK_DEPTH)
-            grouped.resize(ORDERBOOK_DEPTH);
-
-        // Reverse for display: highest price at top, best ask at bottom near spread
-        std::reverse(grouped.begin(), grouped.end());
-
-        populateTable(asksTable, grouped, false, maxTotal);
-    }
-
-    // Parse raw bid levels
-    if (json.contains("bids") && json["bids"].isArray()) {
-        QJsonArray bidsArray = json["bids"].toArray();
-        std::vector<Level> rawBids;
-        rawBids.reserve(bidsArray.size());
-
-        for (const QJsonValue& val : bidsArray) {
-            QJsonArray entry = val.toArray();
-            if (entry.size() >= 2) {
-                bool priceOk = false, qtyOk = false;
-                double price = entry[0].toString().toDouble(&priceOk);
-                double qty = entry[1].toString().toDouble(&qtyOk);
-                if (priceOk && qtyOk && price > 0 && qty >= 0) {
-                    rawBids.push_back({price, qty});
-                }
-            }
-        }
-
-        std::vector<Level> grouped = aggregateLevels(rawBids, true);
-
-        // Take top ORDERBOOK_DEPTH levels (highest bids = best)
-        if ((int)grouped.size() > ORDERBOOK_DEPTH)
-            grouped.resize(ORDERBOOK_DEPTH);
-
-        populateTable(bidsTable, grouped, true, maxTotal);
-    }
-
-    // Calculate spread from best ask and best bid
-    if (bidsTable->rowCount() > 0 && asksTable->rowCount() > 0) {
-        auto* askItem = asksTable->item(asksTable->rowCount() - 1, 0);
-        auto* bidItem = bidsTable->item(0, 0);
-        if (!askItem || !bidItem) return;
-
-        double bestAsk = askItem->text().replace(" ", "").toDouble();
-        double bestBid = bidItem->text().replace(" ", "").toDouble();
-
-        if (bestAsk <= 0) return;
-
-        double spread = bestAsk - bestBid;
-        double percentage = (spread / bestAsk) * 100.0;
-        double fairPrice = (bestAsk + bestBid) / 2.0;
-        spreadLabel->setText(QString("%1  %2%       Fair %3")
-                             .arg(formatNumber(spread, 1))
-                             .arg(formatNumber(percentage, 3))
-                             .arg(formatNumber(fairPrice, 1)));
+void OrderBook::applyGrouping() {
+    // A step below the tick would leave empty rows: never group finer than the tick
+    Price step;
+    if (!Price::parse(groupingCombo->currentText().toStdString(), step) || step < m_symbolInfo.tickSize) {
+        step = m_symbolInfo.tickSize;
     }
+    step = step.ceilTo(m_symbolInfo.tickSize);
+    m_asksModel->setPriceDecimals(step.decimals());
+    m_bidsModel->setPriceDecimals(step.decimals());
+    // Depth per row changes with the grouping (and the symbol)
+    m_asksModel->resetScale();
+    m_bidsModel->resetScale();
+
+    m_aggregator.setStep(step);
+    m_aggregator.rebuild(m_book);
 }
 
-std::vector<OrderBook::Level> OrderBook::aggregateLevels(const std::vector<Level>& raw, bool isBid) {
-    if (raw.empty()) return {};
-
-    // Compute price range
-    double minPrice = raw.front().price;
-    double maxPrice = raw.front().price;
-    for (const auto& lvl : raw) {
-        if (lvl.price < minPrice) minPrice = lvl.price;
-        if (lvl.price > maxPrice) maxPrice = lvl.price;
-    }
-
-    double range = maxPrice - minPrice;
-    if (range <= 0) {
-        // All prices identical — return single level with summed qty
-        double totalQty = 0;
-        for (const auto& lvl : raw) totalQty += lvl.qty;
-        return {{raw.front().price, totalQty}};
-    }
-
-    double step = computeNiceStep(range, ORDERBOOK_DEPTH);
-    if (step <= 0) step = range / ORDERBOOK_DEPTH;
-
-    // Group levels into buckets
-    // Bids: floor to step boundary (round down)
-    // Asks: ceil to step boundary (round up)
-    std::map<double, double> buckets;
-
-    for (const auto& lvl : raw) {
-        double bucket;
-        if (isBid) {
-            bucket = std::floor(lvl.price / step) * step;
-        } else {
-            bucket = std::ceil(lvl.price / step) * step;
+void OrderBook::onBookUpdated(const BookUpdate& update) {
+    if (update.symbol != m_currentSymbol) return;
+
+    if (update.reset) {
+        m_book.applySnapshot(update.bids, update.asks);
+        m_aggregator.rebuild(m_book);
+        m_bookReady = true;
+    } else if (m_bookReady) {
+        // Buckets follow each level change: O(changed levels)
+        for (const Level& lvl : update.bids) {
+            m_aggregator.applyChange(BookSide::Bid, lvl.price, m_book.setLevel(BookSide::Bid, lvl.price, lvl.qty), lvl.qty);
         }
-        buckets[bucket] += lvl.qty;
-    }
-
-    // Convert to vector and sort
-    std::vector<Level> result;
-    result.reserve(buckets.size());
-    for (const auto& [price, qty] : buckets) {
-        if (qty > 0) {
-            result.push_back({price, qty});
+        for (const Level& lvl : update.asks) {
+            m_aggregator.applyChange(BookSide::Ask, lvl.price, m_book.setLevel(BookSide::Ask, lvl.price, lvl.qty), lvl.qty);
         }
-    }
-
-    if (isBid) {
-        // Bids: highest price first (best bid at top)
-        std::sort(result.begin(), result.end(), [](const Level& a, const Level& b) {
-            return a.price > b.price;
-        });
     } else {
-        // Asks: lowest price first (best ask first)
-        std::sort(result.begin(), result.end(), [](const Level& a, const Level& b) {
-            return a.price < b.price;
-        });
+        return;
     }
-
-    return result;
+    scheduleRender();
 }
 
-double OrderBook::computeNiceStep(double range, int targetBuckets) {
-    if (targetBuckets <= 0) return range;
-
-    double rawStep = range / targetBuckets;
-
-    // Find the magnitude (power of 10)
-    double magnitude = std::pow(10.0, std::floor(std::log10(rawStep)));
-
-    double normalized = rawStep / magnitude;
-
-    // Round to nearest "nice" number: 1, 2, 5
-    double niceNorm;
-    if (normalized <= 1.5)
-        niceNorm = 1.0;
-    else if (normalized <= 3.5)
-        niceNorm = 2.0;
-    else if (normalized <= 7.5)
-        niceNorm = 5.0;
-    else
-        niceNorm = 10.0;
-
-    return niceNorm * magnitude;
+void OrderBook::scheduleRender() {
+    // Diffs may arrive faster than the screen refreshes: render once per frame
+    if (!m_renderTimer->isActive()) m_renderTimer->start();
 }
 
-void OrderBook::populateTable(QTableWidget* table, const std::vector<Level>& levels, bool isBid, double& maxTotal) {
-    table->setRowCount(0);
-
-    // Calculate cumulative totals
-    std::vector<double> totals(levels.size());
-    double currentTotal = 0;
-
-    if (isBid) {
-        // Bids: sorted High to Low, sum from top
-        for (size_t i = 0; i < levels.size(); ++i) {
-            currentTotal += levels[i].qty;
-            totals[i] = currentTotal;
-        }
-    } else {
-        // Asks: sorted High to Low for display, sum from bottom (best ask)
-        for (int i = levels.size() - 1; i >= 0; --i) {
-            currentTotal += levels[i].qty;
-            totals[i] = currentTotal;
-        }
-    }
-
-    maxTotal = currentTotal;
-
-    for (size_t i = 0; i < levels.size(); ++i) {
-        int row = table->rowCount();
-        table->insertRow(row);
+void OrderBook::renderBook() {
+    renderSide(m_asksModel);
+    renderSide(m_bidsModel);
+}
 
-        QTableWidgetItem* priceItem = new QTableWidgetItem(formatNumber(levels[i].price, 1));
-        QTableWidgetItem* qtyItem = new QTableWidgetItem(formatBTC(levels[i].qty));
-        QTableWidgetItem* totalItem = new QTableWidgetItem(formatBTC(totals[i]));
+void OrderBook::renderSide(DepthLadderModel* model) {
+    // Best m_ladderDepth buckets; the model orders them for display
+    m_aggregator.buckets().top(model->side(), m_ladderDepth, m_rowLevels);
+    model->setLevels(m_rowLevels);
 
-        for (auto* item : {priceItem, qtyItem, totalItem}) {
-            item->setData(Qt::UserRole, totals[i]);
-            item->setData(Qt::UserRole + 1, maxTotal);
-            item->setData(Qt::UserRole + 2, isBid);
-        }
-
-        table->setItem(row, 0, priceItem);
-        table->setItem(row, 1, qtyItem);
-        table->setItem(row, 2, totalItem);
-    }
-
-    table->setVerticalScrollBarPolicy(Qt::ScrollBarAsNeeded);
+    // Each side's bars scale to its own cumulative depth, rescaled rarely
+    model->fitScale(model->total().toDouble());
 }
 
-QString OrderBook::formatNumber(double value, int decimals) {
-    QString str = QString::number(value, 'f', decimals);
-    int pos = str.indexOf('.');
-    if (pos == -1) pos = str.length();
-    while (pos > 3) {
-        pos -= 3;
-        str.insert(pos, ' ');
+void OrderBook::onBookMetrics(const BookMetrics& metrics) {
+    // Computed by the hub on the raw book, not from grouped rows
+    if (metrics.symbol != m_currentSymbol || !metrics.stats.valid) return;
+
+    // The ladder keeps showing the last good book until the resync lands
+    const bool resyncing = metrics.integrity.resyncing;
+    if (resyncing != m_resyncShown) {
+        m_resyncShown = resyncing;
+        spreadLabel->setStyleSheet(QString("color: %1; font-size: 10pt; padding: 5px; background-color: #202020; font-family: Consolas, monospace;")
+                                   .arg(resyncing ? "#f0b90b" : "#aaa"));
     }
-    return str;
-}
 
-QString OrderBook::formatBTC(double value) {
-    return QString::number(value, 'f', 4);
+    const BookStats& stats = metrics.stats;
+    const int decimals = m_symbolInfo.priceDecimals();
+    spreadLabel->setText(QString("%1%2  %3%    Micro %4    Imb %5%6%")
+                         .arg(resyncing ? "RESYNCING  " : "")
+                         .arg(DepthLadderModel::formatNumber(stats.spread, decimals))
+                         .arg(DepthLadderModel::formatNumber(stats.spread / stats.bestAsk * 100.0, 3))
+                         .arg(DepthLadderModel::formatNumber(stats.microprice, decimals))
+                         .arg(stats.imbalance >= 0 ? "+" : "")
+                         .arg(stats.imbalance * 100.0, 0, 'f', 1));
 }
@@ -6,46 +6,59 @@
  * - Asks (sell orders) sorted by price
  * - Bids (buy orders) sorted by price
  * - Visual depth bars showing cumulative volume
- * - Spread calculation and fair price display
- * - Real-time data via Binance REST API (polled every 1s)
- * - Price level grouping for readable depth display
+ * - Spread bar from BookAnalytics: spread, microprice, top-N imbalance
+ * - Real-time data from MarketDataHub (diff-depth stream, REST fallback),
+ *   kept in a local L2Book the widget only renders from
+ * - User-selected price grouping (header combo), maintained incrementally
+ *   by a BookAggregator on exact tick multiples
+ * - Model/view ladder: rows are diffed in place and repainted per changed
+ *   cell, rendering is coalesced to display rate
+ * - Scrollable ladder up to thousands of levels per side (header combo);
+ *   fixed row heights keep the views virtualized, painting visible rows only
  */
 
 #ifndef ORDERBOOK_H
 #define ORDERBOOK_H
 
 #include <QWidget>
-#include <QTableWidget>
+#include <QTableView>
 #include <QLabel>
 #include <QTimer>
 #include <QStyledItemDelegate>
 #include <QPainter>
-#include <QNetworkAccessManager>
-#include <QNetworkReply>
-#include <QJsonDocument>
-#include <QJsonObject>
-#include <QJsonArray>
+#include <QComboBox>
+#include <algorithm>
 #include <vector>
+#include "BookAggregator.h"
+#include "DepthLadderModel.h"
+#include "L2Book.h"
+#include "MarketEvents.h"
+#include "SymbolRegistry.h"
 
 /**
  * @class DepthDelegate
  * @brief Custom delegate for rendering depth bars behind order book rows.
+ *
+ * Reads the row straight from its DepthLadderModel: no QVariant round trip
+ * for the bar value, scale or side.
  */
 class DepthDelegate : public QStyledItemDelegate {
 public:
     DepthDelegate(QObject* parent = nullptr) : QStyledItemDelegate(parent) {}
 
     void paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const override {
+        const auto* model = static_cast<const DepthLadderModel*>(index.model());
+        const DepthLadderModel::Row& row = model->row(index.row());
+        const bool isBid = model->side() == BookSide::Bid;
+
         painter->save();
 
         painter->fillRect(option.rect, QColor("#161616"));
 
-        double value = index.data(Qt::UserRole).toDouble();
-        double maxTotal = index.data(Qt::UserRole + 1).toDouble();
-        bool isBid = index.data(Qt::UserRole + 2).toBool();
-
+        const double value = row.total.toDouble();
+        const double maxTotal = model->scale();
         if (maxTotal > 0 && value > 0) {
-            double ratio = value / maxTotal;
+            double ratio = std::min(value / maxTotal, 1.0);
             int width = static_cast<int>(option.rect.width() * ratio);
 
             QRect barRect = option.rect;
@@ -55,12 +68,20 @@ public:
             painter->fillRect(barRect, barColor);
         }
 
-        QString text = index.data(Qt::DisplayRole).toString();
-
-        if (index.column() == 0) {
-             painter->setPen(isBid ? QColor("#0ecb81") : QColor("#f6465d"));
-        } else {
-             painter->setPen(QColor("#c3c5cb"));
+        QString text;
+        switch (index.column()) {
+        case DepthLadderModel::PriceColumn:
+            painter->setPen(isBid ? QColor("#0ecb81") : QColor("#f6465d"));
+            text = DepthLadderModel::formatNumber(row.price.toDouble(), model->priceDecimals());
+            break;
+        case DepthLadderModel::AmountColumn:
+            painter->setPen(QColor("#c3c5cb"));
+            text = DepthLadderModel::formatQty(row.qty.toDouble());
+            break;
+        default:
+            painter->setPen(QColor("#c3c5cb"));
+            text = DepthLadderModel::formatQty(row.total.toDouble());
+            break;
         }
 
         painter->setFont(option.font);
@@ -74,12 +95,12 @@ class OrderBook : public QWidget {
     Q_OBJECT
 
 public:
-    static constexpr int ORDERBOOK_DEPTH = 7;
+    static constexpr int LADDER_DEPTHS[] = {20, 100, 500, 1000, 5000};     // Rows per side
+    static constexpr int LADDER_ROW_HEIGHT = 18;
+    static constexpr int RENDER_INTERVAL_MS = 16;   // At most one ladder refresh per frame
+    static constexpr const char* GROUPING_STEPS[] = {"0.01", "0.1", "1", "10", "100"};
 
-    struct Level {
-        double price;
-        double qty;
-    };
+    using Level = BookLevel;
 
     explicit OrderBook(QWidget *parent = nullptr);
     ~OrderBook();
@@ -88,29 +109,36 @@ public slots:
     void setSymbol(const QString& symbol);
 
 private slots:
-    void fetchOrderBook();
-    void onHttpResponse(QNetworkReply* reply);
+    void onBookUpdated(const BookUpdate& update);
+    void onBookMetrics(const BookMetrics& metrics);
 
 private:
     void setupUi();
-    void processDepthData(const QJsonObject& json);
-    void populateTable(QTableWidget* table, const std::vector<Level>& levels, bool isBid, double& maxTotal);
-
-    std::vector<Level> aggregateLevels(const std::vector<Level>& raw, bool isBid);
-    double computeNiceStep(double range, int targetBuckets);
-    QString buildRequestUrl();
-
-    QTableWidget* bidsTable;
-    QTableWidget* asksTable;
+    void renderBook();
+    void scheduleRender();
+    void renderSide(DepthLadderModel* model);
+
+    void applyGrouping();
+    void setupLadder(QTableView* table);
+
+    QTableView* bidsTable;
+    QTableView* asksTable;
+    DepthLadderModel* m_bidsModel;
+    DepthLadderModel* m_asksModel;
+    QTimer* m_renderTimer;
     QLabel* spreadLabel;
-
-    QNetworkAccessManager* m_networkManager;
-    QTimer* m_pollTimer;
+    QComboBox* groupingCombo;
+    QComboBox* depthCombo;
 
     QString m_currentSymbol;
-
-    QString formatNumber(double value, int decimals);
-    QString formatBTC(double value);
+    L2Book m_book;
+    bool m_bookReady = false;   // A reset was received for m_currentSymbol
+    BookAggregator m_aggregator;
+    std::vector<Level> m_rowLevels;     // Scratch rows, reused across renders
+    SymbolInfo m_symbolInfo;
+    int m_ladderDepth = LADDER_DEPTHS[0];
+    bool m_asksPinned = true;   // Asks view follows the best ask at the bottom
+    bool m_resyncShown = false; // Spread bar flags a stale book being resynced
 };
 
 #endif // ORDERBOOK_H
@@ -4,14 +4,61 @@
  * 
  * Initializes the Qt application, applies the global dark theme stylesheet,
  * and displays the main window.
+ *
+ * Command line:
+ *   --record <file>   Append every raw market data payload to a binary log
+ *   --replay <file>   Play a recorded log instead of connecting to the exchange
+ *   --speed <x>       Replay speed: 1 = recorded pacing, N = N times faster, 0 = max
+ *   --exchange <name> Market data venue: binance (default) or mock (offline simulator)
+ *   --rest-url <url>  Binance REST base URL, e.g. a local stand-in (scripts/depth_standin_server.py)
+ *   --ws-url <url>    Binance stream base URL (the combined stream is <url>/stream)
+ *   --live-books <symbols> Comma-separated symbols whose books stay synced in the
+ *                     background (instant switching, cross-symbol analytics)
  */
 
+#include "BinanceAdapter.h"
 #include "MainWindow.h"
+#include "MarketDataHub.h"
+#include "MockExchangeAdapter.h"
 #include <QApplication>
+#include <QCommandLineParser>
 
 int main(int argc, char *argv[]) {
   QApplication a(argc, argv);
 
+  QCommandLineParser parser;
+  parser.setApplicationDescription("Trading Screen");
+  parser.addHelpOption();
+  QCommandLineOption recordOption("record", "Record raw market data to <file>.", "file");
+  QCommandLineOption replayOption("replay", "Replay market data from <file> (offline).", "file");
+  QCommandLineOption speedOption("speed", "Replay speed (1 = real time, 0 = max).", "x", "1");
+  QCommandLineOption exchangeOption("exchange", "Market data venue: binance or mock.", "name", "binance");
+  QCommandLineOption restUrlOption("rest-url", "Binance REST base URL (default: the exchange).", "url",
+                                   BinanceAdapter::DEFAULT_REST_URL);
+  QCommandLineOption wsUrlOption("ws-url", "Binance stream base URL (default: the exchange).", "url",
+                                 BinanceAdapter::DEFAULT_STREAM_URL);
+  QCommandLineOption liveBooksOption("live-books", "Keep the books of <symbols> (comma separated) synced.", "symbols");
+  parser.addOptions({recordOption, replayOption, speedOption, exchangeOption, restUrlOption, wsUrlOption,
+                     liveBooksOption});
+  parser.process(a);
+
+  // Set up the feed before any widget subscribes
+  MarketDataHub *hub = MarketDataHub::instance();
+  if (parser.value(exchangeOption) == "mock") {
+    hub->setAdapter(std::make_shared<MockExchangeAdapter>());
+  } else if (parser.isSet(restUrlOption) || parser.isSet(wsUrlOption)) {
+    hub->setAdapter(std::make_shared<BinanceAdapter>(parser.value(restUrlOption), parser.value(wsUrlOption)));
+  }
+  if (parser.isSet(replayOption)) {
+    hub->startReplay(parser.value(replayOption), parser.value(speedOption).toDouble());
+  }
+  if (parser.isSet(recordOption)) {
+    hub->startRecording(parser.value(recordOption));
+  }
+  if (parser.isSet(liveBooksOption)) {
+    hub->setLiveBooks(parser.value(liveBooksOption).split(',', Qt::SkipEmptyParts));
+  }
+
   // Apply global dark theme stylesheet
   a.setStyleSheet(
       "QFrame { border: 1px solid #444; background-color: #161616; }"
@@ -23,5 +70,7 @@ int main(int argc, char *argv[]) {
   w.resize(1280, 720);
   w.show();
 
-  return a.exec();
+  int result = a.exec();
+  hub->stopRecording();
+  return result;
 }
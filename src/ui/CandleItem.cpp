@@ -0,0 +1,126 @@
+#include "CandleItem.h"
+#include <QPainter>
+#include <algorithm>
+#include <cmath>
+
+CandleItem::CandleItem(const CandleBuffer *candles, const CandleLod *lod, QGraphicsItem *parent)
+    : QGraphicsItem(parent), m_candles(candles), m_lod(lod) {
+  setAcceptedMouseButtons(Qt::NoButton);
+}
+
+void CandleItem::setView(const QRectF &plot, qint64 t0, qint64 t1, double p0, double p1) {
+  if (plot != m_plot) prepareGeometryChange();
+  m_plot = plot;
+  m_t0 = t0;
+  m_t1 = t1;
+  m_p0 = p0;
+  m_p1 = p1;
+  update();
+}
+
+void CandleItem::setInterval(qint64 intervalMs) {
+  if (intervalMs > 0) m_intervalMs = intervalMs;
+}
+
+void CandleItem::setColors(const QColor &up, const QColor &down) {
+  m_up = up;
+  m_down = down;
+  update();
+}
+
+void CandleItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *, QWidget *) {
+  if (m_candles->empty() || m_plot.isEmpty() || m_t1 <= m_t0 || m_p1 <= m_p0) return;
+
+  m_sx = m_plot.width() / static_cast<double>(m_t1 - m_t0);
+  m_sy = m_plot.height() / (m_p1 - m_p0);
+
+  // Candles overlapping the window, found by binary search on the open times
+  const size_t first = m_candles->lowerBound(m_t0 - m_intervalMs + 1);
+  const size_t last = m_candles->lowerBound(m_t1 + 1);
+  if (first >= last) return;
+
+  for (int side = 0; side < 2; ++side) {
+    m_wicks[side].clear();
+    m_bodies[side].clear();
+  }
+  if (m_intervalMs * m_sx >= MIN_BODY_PX) buildCandles(first, last);
+  else buildColumns(first, last);
+
+  painter->save();
+  painter->setClipRect(m_plot);
+  painter->setRenderHint(QPainter::Antialiasing, false);
+  for (int side = 0; side < 2; ++side) {
+    const QColor &color = side ? m_up : m_down;
+    painter->setPen(QPen(color, 1));
+    painter->drawLines(m_wicks[side]);
+    painter->setPen(Qt::NoPen);
+    painter->setBrush(color);
+    painter->drawRects(m_bodies[side]);
+  }
+  painter->restore();
+}
+
+void CandleItem::buildCandles(size_t first, size_t last) {
+  const int64_t *time = m_candles->times().data();
+  const double *open = m_candles->opens().data();
+  const double *high = m_candles->highs().data();
+  const double *low = m_candles->lows().data();
+  const double *close = m_candles->closes().data();
+
+  const double bodyWidth = std::max(1.0, std::floor(m_intervalMs * m_sx * BODY_RATIO));
+  for (size_t i = first; i < last; ++i) {
+    const int side = close[i] >= open[i] ? 1 : 0;
+    const double x = std::round(xOf(time[i] + m_intervalMs / 2)) + 0.5;
+    m_wicks[side].append(QLineF(x, yOf(high[i]), x, yOf(low[i])));
+
+    const double top = yOf(std::max(open[i], close[i]));
+    const double bottom = yOf(std::min(open[i], close[i]));
+    m_bodies[side].append(QRectF(x - bodyWidth / 2, top, bodyWidth, std::max(1.0, bottom - top)));
+  }
+}
+
+void CandleItem::buildColumns(size_t first, size_t last) {
+  const int64_t *time = m_candles->times().data();
+  const double *open = m_candles->opens().data();
+  const double *high = m_candles->highs().data();
+  const double *low = m_candles->lows().data();
+  const double *close = m_candles->closes().data();
+
+  // Walk pre-merged buckets of at most one pixel instead of raw candles
+  const int k = m_lod->levelFor(1.0 / (m_intervalMs * m_sx));
+  if (k > 0) {
+    const CandleLod::Level &level = m_lod->level(k);
+    open = level.open.data();
+    high = level.high.data();
+    low = level.low.data();
+    close = level.close.data();
+    first >>= k;
+    last = ((last - 1) >> k) + 1;
+  }
+
+  // Several candles per pixel: one low-high bar per column, coloured by its net move
+  int column = static_cast<int>(std::floor(xOf(time[first << k])));
+  double colOpen = open[first], colClose = close[first];
+  double colHigh = high[first], colLow = low[first];
+  auto flush = [&]() {
+    const double x = column + 0.5;
+    const int side = colClose >= colOpen ? 1 : 0;
+    m_wicks[side].append(QLineF(x, yOf(colHigh), x, yOf(colLow)));
+  };
+
+  for (size_t i = first + 1; i < last; ++i) {
+    const int x = static_cast<int>(std::floor(xOf(time[i << k])));
+    if (x != column) {
+      flush();
+      column = x;
+      colOpen = open[i];
+      colHigh = high[i];
+      colLow = low[i];
+    } else {
+      colHigh = std::max(colHigh, high[i]);
+      colLow = std::min(colLow, low[i]);
+    }
+    colClose = close[i];
+  }
+  flush();
+}
@@ -0,0 +1,69 @@
+/**
+ * @file CandleItem.h
+ * @brief Batched candlestick renderer drawn inside the chart plot area.
+ *
+ * Replaces QCandlestickSeries, which creates one QObject and one graphics
+ * item per candle. This is a single scene item reading a CandleBuffer:
+ * each paint binary-searches the visible time range, fills four flat
+ * arrays (up / down wicks, up / down bodies) and draws them with one
+ * drawLines() and one drawRects() per colour. When candles are narrower
+ * than MIN_BODY_PX, candles sharing a pixel column are merged into one
+ * high-low bar, so the number of primitives never exceeds the plot width.
+ *
+ * Zoomed out, those bars are merged from the CandleLod level whose buckets
+ * are at most one pixel wide instead of from raw candles, so the walk per
+ * paint is also bounded by the plot width rather than the series length.
+ */
+
+#ifndef CANDLEITEM_H
+#define CANDLEITEM_H
+
+#include <QColor>
+#include <QGraphicsItem>
+#include <QLineF>
+#include <QRectF>
+#include <QVector>
+#include "CandleBuffer.h"
+#include "CandleLod.h"
+
+/**
+ * @class CandleItem
+ * @brief Renders a CandleBuffer over a time x price view rectangle.
+ */
+class CandleItem : public QGraphicsItem {
+public:
+  static constexpr double BODY_RATIO = 0.7;     // Body width / candle slot
+  static constexpr double MIN_BODY_PX = 3.0;    // Narrower slots draw merged bars only
+
+  CandleItem(const CandleBuffer *candles, const CandleLod *lod, QGraphicsItem *parent = nullptr);
+
+  /// Plot rectangle (parent coordinates) and the time / price ranges it shows.
+  void setView(const QRectF &plot, qint64 t0, qint64 t1, double p0, double p1);
+  void setInterval(qint64 intervalMs);
+  void setColors(const QColor &up, const QColor &down);
+
+  QRectF boundingRect() const override { return m_plot; }
+  void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override;
+
+private:
+  void buildCandles(size_t first, size_t last);
+  void buildColumns(size_t first, size_t last);
+  double xOf(qint64 time) const { return m_plot.left() + (time - m_t0) * m_sx; }
+  double yOf(double price) const { return m_plot.bottom() - (price - m_p0) * m_sy; }
+
+  const CandleBuffer *m_candles;
+  const CandleLod *m_lod;
+  QRectF m_plot;
+  qint64 m_t0 = 0, m_t1 = 0;
+  double m_p0 = 0, m_p1 = 0;
+  double m_sx = 0, m_sy = 0;      // Pixels per ms / per price unit
+  qint64 m_intervalMs = 60000;
+  QColor m_up = QColor("#089981");
+  QColor m_down = QColor("#f23645");
+
+  // Scratch primitives, [0] = down, [1] = up; capacity kept across frames
+  QVector<QLineF> m_wicks[2];
+  QVector<QRectF> m_bodies[2];
+};
+
+#endif // CANDLEITEM_H
@@ -1,10 +1,27 @@
 #include "ChartWidget.h"
+#include "CandleItem.h"
+#include "HeatmapItem.h"
+#include "MarketDataHub.h"
+#include "SymbolRegistry.h"
 #include <QtCharts/QAbstractAxis>
 #include <QDebug>
 #include <QMessageBox>
 #include <QVBoxLayout>
 #include <QGraphicsLayout>
+#include <algorithm>
 #include <cmath>
+#include <limits>
+
+namespace {
+
+/// Moves the last point of @p series, or adds one; undefined values are not plotted.
+void setLastPoint(QLineSeries *series, qreal time, double value, bool appended) {
+  if (std::isnan(value)) return;
+  if (appended || series->count() == 0) series->append(time, value);
+  else series->replace(series->count() - 1, QPointF(time, value));
+}
+
+} // namespace
 
 ChartWidget::ChartWidget(QWidget *parent) : QWidget(parent) {
   // Main layout
@@ -12,11 +29,36 @@ ChartWidget::ChartWidget(QWidget *parent) : QWidget(parent) {
   layout->setContentsMargins(0, 0, 0, 0);
   layout->setSpacing(0);
 
-  m_networkManager = new QNetworkAccessManager(this);
+  m_requestChannel = QString("chart-%1").arg(reinterpret_cast<quintptr>(this), 0, 16);
+
+  MarketDataHub *hub = MarketDataHub::instance();
+  connect(hub, &MarketDataHub::klinesReceived, this, &ChartWidget::onKlinesReceived);
+  connect(hub, &MarketDataHub::klineUpdated, this, &ChartWidget::onKlineUpdated);
+  connect(hub, &MarketDataHub::streamConnectionChanged, this, &ChartWidget::onStreamConnectionChanged);
+  connect(hub, &MarketDataHub::bookUpdated, this, &ChartWidget::onBookUpdated);
 
+  // The live candle comes from the kline stream; REST is only polled while it is down
   m_pollTimer = new QTimer(this);
+  m_pollTimer->setInterval(BACKFILL_POLL_MS);
   connect(m_pollTimer, &QTimer::timeout, this, &ChartWidget::fetchLatestKline);
-  m_pollTimer->start(5000);
+  m_streamLost = !hub->isStreamConnected();
+  if (m_streamLost) m_pollTimer->start();
+
+  m_candleRollTimer = new QTimer(this);
+  m_candleRollTimer->setSingleShot(true);
+  m_candleRollTimer->setTimerType(Qt::PreciseTimer);
+  connect(m_candleRollTimer, &QTimer::timeout, this, &ChartWidget::rollCandle);
+
+  m_heatmapTimer = new QTimer(this);
+  m_heatmapTimer->setInterval(DepthHeatmap::SAMPLE_MS);
+  connect(m_heatmapTimer, &QTimer::timeout, this, &ChartWidget::sampleHeatmap);
+  m_heatmapTimer->start();
+
+  // Mouse moves only record the position; the crosshair and HUD follow once per frame
+  m_hudTimer = new QTimer(this);
+  m_hudTimer->setSingleShot(true);
+  m_hudTimer->setInterval(HUD_FRAME_MS);
+  connect(m_hudTimer, &QTimer::timeout, this, &ChartWidget::updateHud);
 
   setupChart();
   setupRsiChart();
@@ -34,7 +76,14 @@ ChartWidget::ChartWidget(QWidget *parent) : QWidget(parent) {
   loadData("BTC", "1h");
 }
 
-ChartWidget::~ChartWidget() {}
+ChartWidget::~ChartWidget() {
+  if (!m_streamSymbol.isEmpty()) {
+    MarketDataHub::instance()->unsubscribe(MarketDataHub::Stream::Kline, m_streamSymbol, m_streamInterval);
+  }
+  if (!m_depthSymbol.isEmpty()) {
+    MarketDataHub::instance()->unsubscribe(MarketDataHub::Stream::Depth, m_depthSymbol);
+  }
+}
 
 void ChartWidget::setupChart() {
   chart = new QChart();
@@ -66,14 +115,6 @@ void ChartWidget::setupChart() {
   // Layout creation moved to constructor
 
 
-  // --- 1. CANDLESTICK SERIES ---
-  series = new QCandlestickSeries();
-  series->setName("BTC");
-  series->setIncreasingColor(QColor("#089981")); // Teal
-  series->setDecreasingColor(QColor("#f23645")); // Red
-  series->setBodyOutlineVisible(false);
-  chart->addSeries(series);
-
   // --- 2. MOVING AVERAGE SERIES (SMA 20) ---
   maSeries = new QLineSeries();
   maSeries->setName("SMA 20");
@@ -102,7 +143,6 @@ void ChartWidget::setupChart() {
   axisX->setLineVisible(false);
   chart->addAxis(axisX, Qt::AlignBottom);
   
-  series->attachAxis(axisX);
   maSeries->attachAxis(axisX);
 
   // Y Axis (Price) - Right
@@ -114,9 +154,23 @@ void ChartWidget::setupChart() {
   axisY->setLineVisible(false);
   chart->addAxis(axisY, Qt::AlignRight);
   
-  series->attachAxis(axisY);
   maSeries->attachAxis(axisY);
 
+  // --- LIQUIDITY HEATMAP ---
+  // One image item between the plot background (z 0) and the grid / series
+  m_heatmapItem = new HeatmapItem(&m_heatmap, chart);
+  m_heatmapItem->setZValue(0.5);
+
+  // --- 1. CANDLES ---
+  // Above grid and axes, below the SMA line
+  m_candleItem = new CandleItem(&m_candles, &m_candleLod, chart);
+  m_candleItem->setColors(QColor("#089981"), QColor("#f23645")); // Teal / Red
+  m_candleItem->setZValue(4.5);
+
+  connect(chart, &QChart::plotAreaChanged, this, &ChartWidget::updatePlotItems);
+  connect(axisX, &QDateTimeAxis::rangeChanged, this, &ChartWidget::updatePlotItems);
+  connect(axisY, &QValueAxis::rangeChanged, this, &ChartWidget::updatePlotItems);
+
   // --- CROSSHAIR ---
   QPen crosshairPen(QColor("#787b86"), 1, Qt::DashLine);
   crosshairX = new QGraphicsLineItem();
@@ -141,92 +195,101 @@ void ChartWidget::setupChart() {
   chart->scene()->addItem(infoLabel);
 }
 
-void ChartWidget::loadData(const QString &symbol, const QString &interval) {
-  m_currentSymbol = symbol;
-  m_currentInterval = interval;
-
+QString ChartWidget::toExchangeInterval(const QString &interval) {
   // Convert interval mapping if necessary (e.g. "Daily" -> "1d", "1h" -> "1h")
-  QString binanceInterval = interval;
-  if (interval == "Daily") binanceInterval = "1d";
-
-  QString urlStr = QString("https://api.binance.com/api/v3/klines?symbol=%1USDT&interval=%2&limit=500")
-                       .arg(symbol.toUpper())
-                       .arg(binanceInterval);
-
-  qDebug() << "Fetching chart data:" << urlStr;
-
-  QNetworkRequest request{QUrl(urlStr)};
-  QNetworkReply *reply = m_networkManager->get(request);
-  connect(reply, &QNetworkReply::finished, this, [this, reply]() {
-      this->onKlinesReceived(reply);
-  });
+  if (interval == "Daily") return "1d";
+  return interval;
 }
 
-void ChartWidget::onKlinesReceived(QNetworkReply* reply) {
-  reply->deleteLater();
-
-  if (reply->error() != QNetworkReply::NoError) {
-      qDebug() << "HTTP error fetching klines:" << reply->errorString();
-      return;
+qint64 ChartWidget::intervalToMs(const QString &interval) {
+  // "1m", "5m", "1h", "4h", "1d", "1w"
+  QString exchangeInterval = toExchangeInterval(interval);
+  if (exchangeInterval.size() < 2) return 0;
+
+  bool ok = false;
+  qint64 count = exchangeInterval.left(exchangeInterval.size() - 1).toLongLong(&ok);
+  if (!ok || count <= 0) return 0;
+
+  switch (exchangeInterval.back().toLatin1()) {
+  case 'm': return count * 60000LL;
+  case 'h': return count * 3600000LL;
+  case 'd': return count * 86400000LL;
+  case 'w': return count * 7 * 86400000LL;
+  default:  return 0;
   }
+}
 
-  int statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
-  if (statusCode != 200) {
-      qDebug() << "HTTP status fetching klines:" << statusCode;
-      return;
+void ChartWidget::loadData(const QString &symbol, const QString &interval) {
+  m_currentSymbol = symbol;
+  m_currentInterval = interval;
+  m_candleRollTimer->stop();
+  m_candleItem->setInterval(intervalToMs(interval));
+
+  MarketDataHub *hub = MarketDataHub::instance();
+  const QString streamInterval = toExchangeInterval(interval);
+  if (symbol != m_streamSymbol || streamInterval != m_streamInterval) {
+    hub->subscribe(MarketDataHub::Stream::Kline, symbol, streamInterval);
+    if (!m_streamSymbol.isEmpty()) {
+      hub->unsubscribe(MarketDataHub::Stream::Kline, m_streamSymbol, m_streamInterval);
+    }
+    m_streamSymbol = symbol;
+    m_streamInterval = streamInterval;
   }
 
-  QByteArray data = reply->readAll();
-  QJsonDocument doc = QJsonDocument::fromJson(data);
-  if (doc.isNull() || !doc.isArray()) {
-      qDebug() << "Invalid JSON array received for klines.";
-      return;
+  if (symbol != m_depthSymbol) {
+    hub->subscribe(MarketDataHub::Stream::Depth, symbol);
+    if (!m_depthSymbol.isEmpty()) {
+      hub->unsubscribe(MarketDataHub::Stream::Depth, m_depthSymbol);
+    }
+    m_depthSymbol = symbol;
+    m_book.clear();
+    m_bookReady = false;
+    m_heatmap.clear();
+    m_heatmapItem->invalidate();
   }
 
-  QJsonArray klinesArray = doc.array();
+  qDebug() << "Fetching chart data:" << symbol << interval;
+  m_historyRequestId = hub->requestKlines(symbol, streamInterval, HISTORY_LIMIT, m_requestChannel + "/history");
+  m_pageRequestId = 0;
+  m_historyComplete = false;
+}
 
-  series->clear();
-  maSeries->clear();
-  
-  qint64 minTimestamp = std::numeric_limits<qint64>::max();
-  qint64 maxTimestamp = std::numeric_limits<qint64>::min();
-  double minPrice = std::numeric_limits<double>::max();
-  double maxPrice = std::numeric_limits<double>::min();
-
-  QList<double> closes; // For SMA calculation
-
-  for (const QJsonValue& val : klinesArray) {
-    if (!val.isArray()) continue;
-    QJsonArray kline = val.toArray();
-    if (kline.size() < 6) continue;
-
-    qint64 ts = (qint64)kline[0].toDouble();
-    double open = kline[1].toString().toDouble();
-    double high = kline[2].toString().toDouble();
-    double low = kline[3].toString().toDouble();
-    double close = kline[4].toString().toDouble();
-    // double volume = kline[5].toString().toDouble();
-
-    // Candle
-    QCandlestickSet *set = new QCandlestickSet(open, high, low, close, ts);
-    series->append(set);
-
-    // SMA Calculation
-    closes.append(close);
-    if (closes.size() >= 20) {
-        double sum = 0;
-        for (int i = closes.size() - 20; i < closes.size(); ++i) sum += closes[i];
-        maSeries->append(ts, sum / 20.0);
-    }
+void ChartWidget::onKlinesReceived(const KlineBatch &batch) {
+  if (batch.requestId == 0) return;
+  if (batch.requestId == m_historyRequestId) {
+      m_historyRequestId = 0;
+      applyHistory(batch);
+  } else if (batch.requestId == m_latestRequestId) {
+      applyLatest(batch);
+  } else if (batch.requestId == m_pageRequestId) {
+      m_pageRequestId = 0;
+      applyPage(batch);
+  }
+}
 
-    if (ts < minTimestamp) minTimestamp = ts;
-    if (ts > maxTimestamp) maxTimestamp = ts;
-    if (low < minPrice) minPrice = low;
-    if (high > maxPrice) maxPrice = high;
+void ChartWidget::applyHistory(const KlineBatch &batch) {
+  m_candles.clear();
+  m_candles.reserve(batch.klines.size());
+  for (const Kline &kline : batch.klines) {
+    Candle candle;
+    candle.openTime = kline.openTime;
+    candle.open = kline.open;
+    candle.high = kline.high;
+    candle.low = kline.low;
+    candle.close = kline.close;
+    candle.volume = kline.volume;
+    m_candles.upsert(candle);
   }
+  m_candleLod.rebuild(m_candles);
+  m_hudIndex = NO_CANDLE;
+
+  double minPrice = 0, maxPrice = 0;
+  if (m_candles.priceRange(0, m_candles.size(), minPrice, maxPrice)) {
+    // The view ends with the live candle, so live heatmap columns land inside it
+    m_liveEdge = liveEdge();
+    qint64 minTimestamp = m_candles.times().front();
+    qint64 maxTimestamp = m_liveEdge;
 
-  if (series->count() > 0 && minTimestamp != std::numeric_limits<qint64>::max() && maxTimestamp != std::numeric_limits<qint64>::min()) {
-    
     // Safety check for flat ranges
     if (minTimestamp >= maxTimestamp) {
         maxTimestamp = minTimestamp + 86400000; // Adds 1 day
@@ -243,83 +306,317 @@ void ChartWidget::onKlinesReceived(QNetworkReply* reply) {
     // Sync RSI Axis
     rsiAxisX->setRange(QDateTime::fromMSecsSinceEpoch(minTimestamp),
                        QDateTime::fromMSecsSinceEpoch(maxTimestamp));
-                       
-    // Calculate RSI
-    QList<qint64> timestamps;
-    QList<double> closePricesForRsi;
-    QList<qint64> timestampsForRsi;
-    
-    for (int i = 0; i < series->count(); ++i) {
-        QCandlestickSet *set = series->sets().at(i);
-        closePricesForRsi.append(set->close());
-        timestampsForRsi.append((qint64)set->timestamp());
-    }
-    
-    calculateRSI(closePricesForRsi, timestampsForRsi);
-    
-    // Update RSI limits lines (30/70)
-    if (m_rsiUpperLimit && m_rsiLowerLimit) {
-        m_rsiUpperLimit->clear();
-        m_rsiLowerLimit->clear();
-        m_rsiUpperLimit->append(minTimestamp, 70);
-        m_rsiUpperLimit->append(maxTimestamp, 70);
-        m_rsiLowerLimit->append(minTimestamp, 30);
-        m_rsiLowerLimit->append(maxTimestamp, 30);
-    }
 
     axisY->setRange(minPrice * 0.99, maxPrice * 1.01);
   }
+
+  rebuildIndicators();
+  m_candleItem->update();
+  armCandleRoll();
+}
+
+void ChartWidget::applyPage(const KlineBatch &batch) {
+  if (m_candles.empty()) return;
+
+  // Only what is older than the loaded history; the page may overlap it
+  const qint64 first = m_candles.times().front();
+  std::vector<Candle> older;
+  older.reserve(batch.klines.size());
+  for (const Kline &kline : batch.klines) {
+    if (kline.openTime >= first) break;
+    Candle candle;
+    candle.openTime = kline.openTime;
+    candle.open = kline.open;
+    candle.high = kline.high;
+    candle.low = kline.low;
+    candle.close = kline.close;
+    candle.volume = kline.volume;
+    older.push_back(candle);
+  }
+  if (older.empty()) {
+    m_historyComplete = true;
+    return;
+  }
+
+  // The view stays where it is; candles and levels shift under it
+  m_candles.prepend(older);
+  m_candleLod.rebuild(m_candles);
+  m_hudIndex = NO_CANDLE;
+  rebuildIndicators();
+  m_candleItem->update();
+
+  // Keep paging while the view is still near the start
+  prefetchHistory();
+}
+
+void ChartWidget::prefetchHistory() {
+  // Initial history first, then one page at a time
+  if (m_historyRequestId != 0 || m_pageRequestId != 0 || m_historyComplete || m_candles.empty()) return;
+  const qint64 intervalMs = intervalToMs(m_currentInterval);
+  if (intervalMs <= 0) return;
+
+  const qint64 t0 = axisX->min().toMSecsSinceEpoch();
+  const qint64 span = axisX->max().toMSecsSinceEpoch() - t0;
+  const qint64 first = m_candles.times().front();
+  if (t0 - static_cast<qint64>(span * PREFETCH_SPANS) > first) return;
+
+  // Pages end on fixed boundaries so the hub's page cache can serve them again.
+  // The page holding first - 1 may reach the live candle: page from first instead.
+  const qint64 pageMs = intervalMs * HISTORY_PAGE;
+  qint64 end = ((first - 1) / pageMs + 1) * pageMs - 1;
+  if (end >= m_candles.lastTime()) end = first - 1;
+
+  m_pageRequestId = MarketDataHub::instance()->requestKlinePage(
+      m_currentSymbol, toExchangeInterval(m_currentInterval), end, HISTORY_PAGE, m_requestChannel + "/page");
+}
+
+void ChartWidget::rebuildIndicators() {
+  m_indicators.reset(m_candles);
+  plotIndicators();
+}
+
+bool ChartWidget::indicatorWindow(size_t &first, size_t &last, size_t &stride) const {
+  // Columns out of step with the candles while history is being replaced
+  if (m_candles.empty() || m_indicators.sma().size() != m_candles.size()) return false;
+
+  const qint64 t0 = axisX->min().toMSecsSinceEpoch();
+  const qint64 t1 = axisX->max().toMSecsSinceEpoch();
+  const qint64 intervalMs = std::max<qint64>(intervalToMs(m_currentInterval), 1);
+
+  // Visible candles as in CandleItem::paint, plus one on each side so the lines reach the edges
+  first = m_candles.lowerBound(t0 - intervalMs + 1);
+  last = m_candles.lowerBound(t1 + 1);
+  if (first > 0) --first;
+  if (last < m_candles.size()) ++last;
+
+  // Zoomed out: about one point per pixel, stepping like the LOD level CandleItem draws
+  const double width = std::max(1.0, chart->plotArea().width());
+  const double candlesPerPixel = static_cast<double>(std::max<qint64>(t1 - t0, 1)) / intervalMs / width;
+  stride = size_t(1) << m_candleLod.levelFor(candlesPerPixel);
+  first -= first % stride;
+  return first < last;
+}
+
+void ChartWidget::plotIndicators() {
+  size_t first = 0, last = 0, stride = 1;
+  if (!indicatorWindow(first, last, stride)) {
+    maSeries->clear();
+    rsiSeries->clear();
+    m_plotFirst = m_plotLast = m_plotStride = 0;
+    return;
+  }
+  m_plotFirst = first;
+  m_plotLast = last;
+  m_plotStride = stride;
+
+  // Each line handed to its series in one call, the last candle always included
+  const std::vector<int64_t> &times = m_candles.times();
+  const std::vector<double> &sma = m_indicators.sma();
+  const std::vector<double> &rsi = m_indicators.rsi();
+  QList<QPointF> maPoints;
+  QList<QPointF> rsiPoints;
+  const qsizetype count = static_cast<qsizetype>((last - first) / stride + 2);
+  maPoints.reserve(count);
+  rsiPoints.reserve(count);
+  auto plot = [&](size_t i) {
+    if (!std::isnan(sma[i])) maPoints.append(QPointF(times[i], sma[i]));
+    if (!std::isnan(rsi[i])) rsiPoints.append(QPointF(times[i], rsi[i]));
+  };
+  for (size_t i = first; i < last; i += stride) plot(i);
+  if ((last - 1 - first) % stride != 0) plot(last - 1);
+  maSeries->replace(maPoints);
+  rsiSeries->replace(rsiPoints);
+
+  // Update RSI limits lines (30/70) across the plotted window
+  if (m_rsiUpperLimit && m_rsiLowerLimit) {
+      const qreal left = times[first];
+      const qreal right = times[last - 1];
+      m_rsiUpperLimit->replace({QPointF(left, 70), QPointF(right, 70)});
+      m_rsiLowerLimit->replace({QPointF(left, 30), QPointF(right, 30)});
+  }
+}
+
+void ChartWidget::plotLastIndicators(bool appended) {
+  // Only when the series end at the live candle; otherwise it is outside the view
+  const size_t size = m_candles.size();
+  if (m_plotLast != (appended ? size - 1 : size)) return;
+  if (appended) m_plotLast = size;
+
+  const size_t last = size - 1;
+  const qreal time = m_candles.lastTime();
+  setLastPoint(maSeries, time, m_indicators.sma()[last], appended);
+  setLastPoint(rsiSeries, time, m_indicators.rsi()[last], appended);
+
+  // RSI limit lines follow the new candle
+  if (appended && m_rsiUpperLimit && m_rsiLowerLimit) {
+      setLastPoint(m_rsiUpperLimit, time, 70, false);
+      setLastPoint(m_rsiLowerLimit, time, 30, false);
+  }
 }
 
 void ChartWidget::fetchLatestKline() {
   if (m_currentSymbol.isEmpty() || m_currentInterval.isEmpty()) return;
-  if (series->count() == 0) return; // Wait for full history to load
-
-  QString binanceInterval = m_currentInterval;
-  if (m_currentInterval == "Daily") binanceInterval = "1d";
-
-  // Limit 2 captures boundary crossing
-  QString urlStr = QString("https://api.binance.com/api/v3/klines?symbol=%1USDT&interval=%2&limit=2")
-                       .arg(m_currentSymbol.toUpper())
-                       .arg(binanceInterval);
-
-  QNetworkRequest request{QUrl(urlStr)};
-  QNetworkReply *reply = m_networkManager->get(request);
-
-  connect(reply, &QNetworkReply::finished, this, [this, reply]() {
-      reply->deleteLater();
-      if (reply->error() != QNetworkReply::NoError) return;
-      
-      QByteArray data = reply->readAll();
-      QJsonDocument doc = QJsonDocument::fromJson(data);
-      if (!doc.isArray()) return;
-      
-      QJsonArray klinesArray = doc.array();
-      if (series->count() == 0) return;
-      
-      for (const QJsonValue& val : klinesArray) {
-          if (!val.isArray()) continue;
-          QJsonArray kline = val.toArray();
-          if (kline.size() < 6) continue;
-          
-          qint64 ts = (qint64)kline[0].toDouble();
-          double open = kline[1].toString().toDouble();
-          double high = kline[2].toString().toDouble();
-          double low = kline[3].toString().toDouble();
-          double close = kline[4].toString().toDouble();
-          
-          QCandlestickSet *lastSet = series->sets().last();
-          
-          if (lastSet->timestamp() == ts) {
-              lastSet->setHigh(high);
-              lastSet->setLow(low);
-              lastSet->setClose(close);
-          } else if (lastSet->timestamp() < ts) {
-              QCandlestickSet *newSet = new QCandlestickSet(open, high, low, close, ts);
-              series->append(newSet);
-          }
-      }
-  });
+  if (m_candles.empty()) return; // Wait for full history to load
+
+  // Cover every candle missed since the last one we have (limit 2 captures boundary crossing)
+  int limit = 2;
+  qint64 intervalMs = intervalToMs(m_currentInterval);
+  if (intervalMs > 0) {
+    qint64 lastTs = m_candles.lastTime();
+    qint64 missed = (QDateTime::currentMSecsSinceEpoch() - lastTs) / intervalMs + 2;
+    limit = (int)qBound<qint64>(2, missed, MAX_BACKFILL_LIMIT);
+  }
+
+  MarketDataHub *hub = MarketDataHub::instance();
+  m_latestRequestId = hub->requestKlines(m_currentSymbol, toExchangeInterval(m_currentInterval), limit,
+                                         m_requestChannel + "/latest");
+
+  // Back off on slow links or when the shared weight budget runs low
+  m_pollTimer->setInterval(hub->pollIntervalMs(BACKFILL_POLL_MS));
+}
+
+void ChartWidget::onStreamConnectionChanged(bool connected) {
+  if (!connected) {
+    // Keep the live candle moving over REST until the stream is back
+    m_streamLost = true;
+    if (!m_pollTimer->isActive()) m_pollTimer->start();
+    return;
+  }
+
+  m_pollTimer->stop();
+  if (m_streamLost) {
+    // One backfill for whatever closed while we were disconnected
+    m_streamLost = false;
+    fetchLatestKline();
+  }
+}
+
+void ChartWidget::onKlineUpdated(const Kline &kline) {
+  if (kline.symbol != m_currentSymbol || kline.interval != toExchangeInterval(m_currentInterval)) return;
+  if (m_candles.empty()) return; // History not loaded yet, it will include this candle
+
+  applyKline(kline.openTime, kline.open, kline.high, kline.low, kline.close);
+}
+
+void ChartWidget::applyLatest(const KlineBatch &batch) {
+  if (batch.symbol != m_currentSymbol) return;
+  if (m_candles.empty()) return;
+
+  for (const Kline &kline : batch.klines) {
+      applyKline(kline.openTime, kline.open, kline.high, kline.low, kline.close);
+  }
+}
+
+void ChartWidget::applyKline(qint64 ts, double open, double high, double low, double close) {
+  Candle candle;
+  candle.openTime = ts;
+  candle.open = open;
+  candle.high = high;
+  candle.low = low;
+  candle.close = close;
+
+  // Update in place; older candles only change when a backfill finalises them
+  const CandleBuffer::Upsert result = m_candles.upsert(candle);
+  if (result == CandleBuffer::Upsert::Ignored) return;
+  const size_t index = m_candles.lowerBound(ts);
+  m_candleLod.update(m_candles, index);
+  m_candleItem->update();
+  switch (m_indicators.update(m_candles, index)) {
+  case IndicatorEngine::Change::Rebuilt:  plotIndicators(); break;
+  case IndicatorEngine::Change::Appended: plotLastIndicators(true); break;
+  case IndicatorEngine::Change::Revised:  plotLastIndicators(false); break;
+  }
+  if (index == m_hudIndex) {
+    // The hovered candle changed under the HUD
+    m_hudIndex = NO_CANDLE;
+    if (crosshairX->isVisible()) scheduleHud();
+  }
+  if (result == CandleBuffer::Upsert::Appended) {
+    armCandleRoll();
+    followLiveEdge();
+  }
+}
+
+qint64 ChartWidget::liveEdge() const {
+  if (m_candles.empty()) return 0;
+  return std::max(m_candles.lastTime() + std::max<qint64>(intervalToMs(m_currentInterval), 1),
+                  QDateTime::currentMSecsSinceEpoch());
+}
+
+void ChartWidget::followLiveEdge() {
+  const qint64 edge = liveEdge();
+  if (m_liveEdge == 0 || edge <= m_liveEdge) return;
+
+  // Only a view showing the previous edge follows; one panned back into history stays put
+  const qint64 t0 = axisX->min().toMSecsSinceEpoch();
+  const qint64 t1 = axisX->max().toMSecsSinceEpoch();
+  const bool pinned = t1 >= m_liveEdge;
+  m_liveEdge = edge;
+  if (!pinned) return;
+
+  // Same span, shifted: the RSI axis and the plot items (heatmap rebuild) follow the signal
+  axisX->setRange(QDateTime::fromMSecsSinceEpoch(t0 + edge - t1), QDateTime::fromMSecsSinceEpoch(edge));
+}
+
+void ChartWidget::armCandleRoll() {
+  qint64 intervalMs = intervalToMs(m_currentInterval);
+  if (intervalMs <= 0 || m_candles.empty()) return;
+
+  qint64 nextOpen = m_candles.lastTime() + intervalMs;
+  qint64 delay = nextOpen - QDateTime::currentMSecsSinceEpoch();
+  m_candleRollTimer->start((int)qBound<qint64>(0, delay, std::numeric_limits<int>::max()));
+}
+
+void ChartWidget::rollCandle() {
+  qint64 intervalMs = intervalToMs(m_currentInterval);
+  if (intervalMs <= 0 || m_candles.empty()) return;
+
+  // Open the new candle at the boundary from the previous close; the stream
+  // overwrites it with exchange values as soon as the first trade prints.
+  qint64 nextOpen = m_candles.lastTime() + intervalMs;
+  if (nextOpen <= QDateTime::currentMSecsSinceEpoch()) {
+      double close = m_candles.closes().back();
+      applyKline(nextOpen, close, close, close, close);
+  } else {
+      armCandleRoll();
+  }
+}
+
+void ChartWidget::onBookUpdated(const BookUpdate &update) {
+  if (update.symbol != m_depthSymbol) return;
+
+  if (update.reset) {
+    m_book.applySnapshot(update.bids, update.asks);
+    m_bookReady = true;
+  } else if (m_bookReady) {
+    m_book.applyChanges(update.bids, update.asks);
+  }
+}
+
+void ChartWidget::sampleHeatmap() {
+  if (!m_bookReady) return;
+
+  const Price tick = SymbolRegistry::instance()->info(m_depthSymbol).tickSize;
+  if (!m_heatmap.sample(m_book, QDateTime::currentMSecsSinceEpoch(), tick)) return;
+
+  followLiveEdge();
+  m_heatmapItem->columnAppended();
+}
+
+void ChartWidget::updatePlotItems() {
+  const QRectF plot = chart->plotArea();
+  const qint64 t0 = axisX->min().toMSecsSinceEpoch();
+  const qint64 t1 = axisX->max().toMSecsSinceEpoch();
+  m_heatmapItem->setView(plot, t0, t1, axisY->min(), axisY->max());
+  m_candleItem->setView(plot, t0, t1, axisY->min(), axisY->max());
+
+  // Indicator lines cover the visible candles only: re-plot when those change
+  size_t first = 0, last = 0, stride = 1;
+  if (indicatorWindow(first, last, stride) &&
+      (first != m_plotFirst || last != m_plotLast || stride != m_plotStride)) {
+    plotIndicators();
+  }
+  prefetchHistory();
 }
 
 bool ChartWidget::eventFilter(QObject *watched, QEvent *event) {
@@ -433,50 +730,8 @@ bool ChartWidget::eventFilter(QObject *watched, QEvent *event) {
 
             // Crosshair & Info Logic (Update ONLY if on Main Chart for now)
             if (targetChart == chart) {
-                QPointF scenePos = chartView->mapToScene(mouseEvent->pos());
-                QPointF chartPos = chart->mapFromScene(scenePos);
-
-                if (chart->plotArea().contains(chartPos)) {
-                    crosshairX->setVisible(true);
-                    crosshairY->setVisible(true);
-                    
-                    updateCrosshair(chartPos);
-
-                    // Update Info Label
-                    if (series->count() > 0) {
-                         QPointF valuePoint = chart->mapToValue(chartPos);
-                         qint64 timestamp = (qint64)valuePoint.x();
-                         
-                         QCandlestickSet *closestSet = nullptr;
-                         qint64 minDiff = std::numeric_limits<qint64>::max();
-
-                         for (auto set : series->sets()) {
-                             qint64 diff = std::abs(set->timestamp() - timestamp);
-                             if (diff < minDiff) {
-                                 minDiff = diff;
-                                 closestSet = set;
-                             }
-                         }
-
-                         if (closestSet && minDiff < 86400000) {
-                             QString info = QString("BTC | %1 | O: %2 | H: %3 | L: %4 | C: %5")
-                                                .arg(QDateTime::fromMSecsSinceEpoch(closestSet->timestamp()).toString("yyyy-MM-dd"))
-                                                .arg(closestSet->open(), 0, 'f', 2)
-                                                .arg(closestSet->high(), 0, 'f', 2)
-                                                .arg(closestSet->low(), 0, 'f', 2)
-                                                .arg(closestSet->close(), 0, 'f', 2);
-                             infoLabel->setPlainText(info);
-                             if (closestSet->close() >= closestSet->open()) {
-                                  infoLabel->setDefaultTextColor(QColor("#089981"));
-                             } else {
-                                  infoLabel->setDefaultTextColor(QColor("#f23645"));
-                             }
-                         }
-                    }
-                } else {
-                    crosshairX->setVisible(false);
-                    crosshairY->setVisible(false);
-                }
+                m_hoverPos = chart->mapFromScene(chartView->mapToScene(mouseEvent->pos()));
+                scheduleHud();
             }
             return true;
         }
@@ -515,11 +770,41 @@ void ChartWidget::enterEvent(QEnterEvent *event) {
 }
 
 void ChartWidget::leaveEvent(QEvent *event) {
+    m_hudTimer->stop();
     crosshairX->setVisible(false);
     crosshairY->setVisible(false);
     QWidget::leaveEvent(event);
 }
 
+void ChartWidget::scheduleHud() {
+    if (!m_hudTimer->isActive()) m_hudTimer->start();
+}
+
+void ChartWidget::updateHud() {
+    const bool inPlot = chart->plotArea().contains(m_hoverPos);
+    crosshairX->setVisible(inPlot);
+    crosshairY->setVisible(inPlot);
+    if (!inPlot) return;
+
+    updateCrosshair(m_hoverPos);
+
+    // Update Info Label: binary search on open times, text rebuilt only when the candle changes
+    const qint64 timestamp = (qint64)chart->mapToValue(m_hoverPos).x();
+    const size_t index = m_candles.indexAt(timestamp);
+    if (index == m_candles.size() || index == m_hudIndex) return;
+    m_hudIndex = index;
+
+    const Candle candle = m_candles.at(index);
+    QString info = QString("BTC | %1 | O: %2 | H: %3 | L: %4 | C: %5")
+                       .arg(QDateTime::fromMSecsSinceEpoch(candle.openTime).toString("yyyy-MM-dd"))
+                       .arg(candle.open, 0, 'f', 2)
+                       .arg(candle.high, 0, 'f', 2)
+                       .arg(candle.low, 0, 'f', 2)
+                       .arg(candle.close, 0, 'f', 2);
+    infoLabel->setPlainText(info);
+    infoLabel->setDefaultTextColor(candle.close >= candle.open ? QColor("#089981") : QColor("#f23645"));
+}
+
 void ChartWidget::updateCrosshair(const QPointF &pos) {
     QRectF plotArea = chart->plotArea();
     
@@ -621,47 +906,7 @@ void ChartWidget::syncMainToRsi() {
         axisX->blockSignals(true);
         axisX->setRange(rsiAxisX->min(), rsiAxisX->max());
         axisX->blockSignals(false);
-    }
-}
-
-void ChartWidget::calculateRSI(const QList<double> &closePrices, const QList<qint64> &timestamps, int period) {
-    rsiSeries->clear();
-    
-    if (closePrices.size() < period + 1) return;
-
-    QList<double> gains;
-    QList<double> losses;
-    
-    // Initial calculation
-    double avgGain = 0;
-    double avgLoss = 0;
-
-    for (int i = 1; i <= period; ++i) {
-        double change = closePrices[i] - closePrices[i - 1];
-        if (change > 0) avgGain += change;
-        else avgLoss += std::abs(change);
-    }
-    
-    avgGain /= period;
-    avgLoss /= period;
-
-    // RSI Formula: RSI = 100 - (100 / (1 + RS))
-    // RS = Average Gain / Average Loss
-
-    for (int i = period; i < closePrices.size(); ++i) {
-        double rs = (avgLoss == 0) ? 100 : (avgGain / avgLoss);
-        double rsi = (avgLoss == 0) ? 100 : (100 - (100 / (1 + rs)));
-        
-        rsiSeries->append(timestamps[i], rsi);
-
-        if (i < closePrices.size() - 1) {
-             double change = closePrices[i + 1] - closePrices[i];
-             double gain = (change > 0) ? change : 0;
-             double loss = (change < 0) ? std::abs(change) : 0;
-             
-             avgGain = (avgGain * (period - 1) + gain) / period;
-             avgLoss = (avgLoss * (period - 1) + loss) / period;
-        }
+        updatePlotItems();
     }
 }
 
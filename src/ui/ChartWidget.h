@@ -5,8 +5,17 @@
  * Displays financial data as a Japanese candlestick chart with:
  * - SMA 20 moving average overlay
  * - RSI (Relative Strength Index) sub-chart
- * - Interactive crosshair and OHLC info display
+ * - Interactive crosshair and OHLC info display, refreshed at most once per frame
+ * - Infinite scroll: older history is paged in as the view nears its start
  * - Pan and zoom functionality
+ * - Live candle driven by the kline stream, REST backfill after disconnects
+ * - Liquidity heatmap of resting depth behind the candles (DepthHeatmap)
+ *
+ * Candles live in a struct-of-arrays CandleBuffer drawn by one CandleItem
+ * (batched QPainter calls), not in a QCandlestickSeries; QtCharts still
+ * provides the axes, the SMA / RSI lines and the pan / zoom plumbing.
+ * SMA and RSI come from an IndicatorEngine: a live or new candle moves
+ * only the last point of each line.
  */
 
 #ifndef CHARTWIDGET_H
@@ -15,11 +24,15 @@
 #include <QWidget>
 #include <QtCharts>
 #include <QtSql> // Still here for now if needed elsewhere, but can be removed
-#include <QNetworkAccessManager>
-#include <QNetworkReply>
-#include <QJsonDocument>
-#include <QJsonObject>
-#include <QJsonArray>
+#include "CandleBuffer.h"
+#include "CandleLod.h"
+#include "IndicatorEngine.h"
+#include "DepthHeatmap.h"
+#include "L2Book.h"
+#include "MarketEvents.h"
+
+class CandleItem;
+class HeatmapItem;
 
 /**
  * @class ChartWidget
@@ -45,14 +58,39 @@ protected:
   void wheelEvent(QWheelEvent *event) override;
 
 private slots:
-  void onKlinesReceived(QNetworkReply* reply);
+  void onKlinesReceived(const KlineBatch &batch);
+  void onKlineUpdated(const Kline &kline);
+  void onStreamConnectionChanged(bool connected);
   void fetchLatestKline();
+  void rollCandle();
+  void onBookUpdated(const BookUpdate &update);
+  void sampleHeatmap();
+  void updatePlotItems();
+  void updateHud();
 
 private:
-  QTimer *m_pollTimer;
+  static constexpr int BACKFILL_POLL_MS = 5000;
+  static constexpr int MAX_BACKFILL_LIMIT = 1000;
+  static constexpr int HUD_FRAME_MS = 16;
+  static constexpr int HISTORY_LIMIT = 500;       // Candles of the initial load
+  static constexpr int HISTORY_PAGE = 1000;       // Candles per older page (venue max)
+  static constexpr double PREFETCH_SPANS = 1.0;   // Page in while the view is this many widths from the start
+  static constexpr size_t NO_CANDLE = static_cast<size_t>(-1);
+
+  QTimer *m_pollTimer;        // REST backfill, only while the stream is down
+  QTimer *m_candleRollTimer;  // Fires exactly at the next interval boundary
+  QTimer *m_heatmapTimer;     // Samples the book every DepthHeatmap::SAMPLE_MS
+  QTimer *m_hudTimer;         // Coalesces mouse moves into one crosshair / HUD update per frame
   QChartView *chartView;
   QChart *chart;
-  QCandlestickSeries *series;
+  CandleBuffer m_candles;
+  CandleLod m_candleLod;     // Merged levels for zoomed-out paints
+  IndicatorEngine m_indicators; // SMA 20 / RSI 14, aligned with m_candles
+  // Candles [first, last) the indicator series hold, one every stride
+  size_t m_plotFirst = 0;
+  size_t m_plotLast = 0;
+  size_t m_plotStride = 0;
+  CandleItem *m_candleItem;
   // QBarSeries *volumeSeries; // Removed
   QLineSeries *maSeries;    // Moving Average
   
@@ -66,6 +104,8 @@ private:
   QGraphicsTextItem *priceLabel;
   QGraphicsTextItem *dateLabel;
   QGraphicsTextItem *infoLabel; // HUD for candle info
+  QPointF m_hoverPos;           // Latest mouse position, chart coordinates
+  size_t m_hudIndex = NO_CANDLE; // Candle the HUD text was built for
 
   // Panning & Zooming state
   enum class DragMode { None, Pan, ZoomX, ZoomY };
@@ -73,10 +113,25 @@ private:
   bool m_isDragging = false;
   QPoint m_lastMousePos;
 
-  // Network and State
-  QNetworkAccessManager *m_networkManager;
+  // Data requests (served by MarketDataHub) and State
+  quint64 m_historyRequestId = 0;
+  quint64 m_latestRequestId = 0;
+  quint64 m_pageRequestId = 0;      // Older page in flight, one at a time
+  bool m_historyComplete = false;   // The venue has nothing older
+  qint64 m_liveEdge = 0;            // End of the live candle (or now); a view ending there follows it
   QString m_currentSymbol;
   QString m_currentInterval;
+  QString m_requestChannel;   // Per-chart klines channel: newer requests supersede older ones
+  QString m_streamSymbol;     // Kline stream currently subscribed
+  QString m_streamInterval;
+  bool m_streamLost = false;
+
+  // Heatmap: local book replica of the chart symbol, sampled into the ring
+  QString m_depthSymbol;
+  L2Book m_book;
+  bool m_bookReady = false;
+  DepthHeatmap m_heatmap;
+  HeatmapItem *m_heatmapItem;
 
   // RSI Components
   QChartView *rsiChartView;
@@ -88,7 +143,21 @@ private:
   void setupChart();
   void setupRsiChart();
   void updateCrosshair(const QPointF &point);
-  void calculateRSI(const QList<double> &closePrices, const QList<qint64> &timestamps, int period = 14);
+  void scheduleHud();
+  void applyHistory(const KlineBatch &batch);
+  void applyLatest(const KlineBatch &batch);
+  void applyPage(const KlineBatch &batch);
+  void prefetchHistory();
+  void rebuildIndicators();
+  bool indicatorWindow(size_t &first, size_t &last, size_t &stride) const;
+  void plotIndicators();
+  void plotLastIndicators(bool appended);
+  void applyKline(qint64 ts, double open, double high, double low, double close);
+  qint64 liveEdge() const;
+  void followLiveEdge();
+  void armCandleRoll();
+  static QString toExchangeInterval(const QString &interval);
+  static qint64 intervalToMs(const QString &interval);
   
   // Bidirectional axis sync slots
   void syncRsiToMain();
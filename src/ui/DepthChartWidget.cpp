@@ -0,0 +1,228 @@
+#include "DepthChartWidget.h"
+#include "MarketDataHub.h"
+#include "SymbolRegistry.h"
+#include <QPainter>
+#include <QWheelEvent>
+#include <algorithm>
+
+DepthChartWidget::DepthChartWidget(QWidget *parent) : QWidget(parent), m_symbol("BTC") {
+  setMinimumHeight(120);
+  setAttribute(Qt::WA_OpaquePaintEvent);
+
+  // Book updates only mark the chart dirty; it is painted at most once per frame
+  m_frameTimer = new QTimer(this);
+  m_frameTimer->setInterval(FRAME_INTERVAL_MS);
+  connect(m_frameTimer, &QTimer::timeout, this, &DepthChartWidget::onFrame);
+  m_frameTimer->start();
+
+  MarketDataHub *hub = MarketDataHub::instance();
+  connect(hub, &MarketDataHub::bookUpdated, this, &DepthChartWidget::onBookUpdated);
+  hub->subscribe(MarketDataHub::Stream::Depth, m_symbol);
+}
+
+DepthChartWidget::~DepthChartWidget() {
+  MarketDataHub::instance()->unsubscribe(MarketDataHub::Stream::Depth, m_symbol);
+}
+
+void DepthChartWidget::setSymbol(const QString &symbol) {
+  if (symbol == m_symbol) return;
+
+  MarketDataHub *hub = MarketDataHub::instance();
+  hub->subscribe(MarketDataHub::Stream::Depth, symbol);
+  hub->unsubscribe(MarketDataHub::Stream::Depth, m_symbol);
+  m_symbol = symbol;
+  m_book.clear();
+  m_bookReady = false;
+  m_chunkWidth = Price();   // Depends on the new tick and price
+  resetChunks();
+  update();
+}
+
+void DepthChartWidget::onBookUpdated(const BookUpdate &update) {
+  if (update.symbol != m_symbol) return;
+
+  if (update.reset) {
+    m_book.applySnapshot(update.bids, update.asks);
+    m_bookReady = true;
+    resetChunks();
+  } else if (m_bookReady) {
+    markDirty(BookSide::Bid, update.bids);
+    markDirty(BookSide::Ask, update.asks);
+    m_book.applyChanges(update.bids, update.asks);
+  } else {
+    return;
+  }
+  m_dirty = true;
+}
+
+void DepthChartWidget::onFrame() {
+  if (!m_dirty) return;
+  m_dirty = false;
+  update();
+}
+
+void DepthChartWidget::wheelEvent(QWheelEvent *event) {
+  const double factor = event->angleDelta().y() > 0 ? 0.8 : 1.25;
+  m_window = std::clamp(m_window * factor, MIN_WINDOW, MAX_WINDOW);
+  // New chunk width for the new window
+  m_chunkWidth = Price();
+  resetChunks();
+  update();
+  event->accept();
+}
+
+void DepthChartWidget::resetChunks() {
+  m_bidChunks.clear();
+  m_askChunks.clear();
+}
+
+void DepthChartWidget::markDirty(BookSide side, const std::vector<BookLevel> &levels) {
+  if (!m_chunkWidth.isPositive()) return;
+  ChunkMap &map = chunks(side);
+  for (const BookLevel &lvl : levels) {
+    auto it = map.find(chunkOf(lvl.price));
+    if (it != map.end()) it->dirty = true;
+  }
+}
+
+void DepthChartWidget::rebuild(BookSide side, int64_t index, Chunk &chunk) {
+  const Price lo = Price::fromRaw(index * m_chunkWidth.raw());
+  const Price hi = lo + m_chunkWidth;
+  const std::vector<BookLevel> &levels = m_book.sideLevels(side);
+
+  // Both sides are stored worst to best: walk the chunk's run from the mid outwards
+  std::vector<BookLevel>::const_iterator first, last;
+  double start, end;
+  if (side == BookSide::Bid) {
+    auto below = [](const BookLevel &lvl, Price price) { return lvl.price < price; };
+    first = std::lower_bound(levels.begin(), levels.end(), lo, below);
+    last = std::lower_bound(first, levels.end(), hi, below);
+    start = hi.toDouble();
+    end = lo.toDouble();
+  } else {
+    first = std::partition_point(levels.begin(), levels.end(), [hi](const BookLevel &lvl) { return lvl.price >= hi; });
+    last = std::partition_point(first, levels.end(), [lo](const BookLevel &lvl) { return lvl.price >= lo; });
+    start = lo.toDouble();
+    end = hi.toDouble();
+  }
+
+  QPainterPath line;
+  double y = 0;
+  line.moveTo(start, 0);
+  for (auto it = last; it != first;) {
+    --it;
+    const double price = it->price.toDouble();
+    line.lineTo(price, y);
+    y += it->qty.toDouble();
+    line.lineTo(price, y);
+  }
+  line.lineTo(end, y);
+
+  chunk.fill = line;
+  chunk.fill.lineTo(end, 0);
+  chunk.fill.closeSubpath();
+  chunk.line = line;
+  chunk.qty = y;
+  chunk.dirty = false;
+}
+
+void DepthChartWidget::paintSide(QPainter &painter, BookSide side, int64_t first, int64_t last,
+                                 const QTransform &base, double yScale) {
+  const bool isBid = side == BookSide::Bid;
+  const QColor color = isBid ? QColor("#0ecb81") : QColor("#f6465d");
+  QColor area = color;
+  area.setAlpha(50);
+  QPen pen(color, 1.5);
+  pen.setCosmetic(true);
+
+  ChunkMap &map = chunks(side);
+  const int64_t step = isBid ? -1 : 1;
+  const double width = m_chunkWidth.toDouble();
+  double offset = 0;
+  for (int64_t k = first; isBid ? k >= last : k <= last; k += step) {
+    const Chunk &chunk = map[k];
+
+    // Depth in front of the chunk, then the chunk's cached shape raised by it
+    painter.setTransform(base);
+    if (offset * yScale >= 0.5) painter.fillRect(QRectF(k * width, 0, width, offset), area);
+    painter.setTransform(QTransform::fromTranslate(0, offset) * base);
+    painter.fillPath(chunk.fill, area);
+    painter.strokePath(chunk.line, pen);
+    offset += chunk.qty;
+  }
+}
+
+void DepthChartWidget::paintEvent(QPaintEvent *) {
+  QPainter painter(this);
+  painter.fillRect(rect(), QColor("#161616"));
+
+  const BookLevel *bid = m_book.bestBid();
+  const BookLevel *ask = m_book.bestAsk();
+  if (!m_bookReady || !bid || !ask) return;
+
+  const double mid = (bid->price.toDouble() + ask->price.toDouble()) / 2.0;
+  const double half = mid * m_window;
+  const double lo = mid - half, hi = mid + half;
+  if (!m_chunkWidth.isPositive()) {
+    const Price tick = SymbolRegistry::instance()->info(m_symbol).tickSize;
+    m_chunkWidth = Price::fromDouble(half / CHUNKS_PER_SIDE).ceilTo(tick);
+    if (!m_chunkWidth.isPositive()) m_chunkWidth = tick;
+  }
+
+  const int64_t bidFirst = chunkOf(bid->price), bidLast = chunkOf(Price::fromDouble(lo));
+  const int64_t askFirst = chunkOf(ask->price), askLast = chunkOf(Price::fromDouble(hi));
+
+  // Bring the visible chunks up to date; the totals at the edges give the scale
+  double bidTotal = 0, askTotal = 0;
+  for (int64_t k = bidFirst; k >= bidLast; --k) {
+    Chunk &chunk = m_bidChunks[k];
+    if (chunk.dirty) rebuild(BookSide::Bid, k, chunk);
+    bidTotal += chunk.qty;
+  }
+  for (int64_t k = askFirst; k <= askLast; ++k) {
+    Chunk &chunk = m_askChunks[k];
+    if (chunk.dirty) rebuild(BookSide::Ask, k, chunk);
+    askTotal += chunk.qty;
+  }
+  const double yMax = std::max(bidTotal, askTotal) * 1.1;
+
+  const QRectF plot = QRectF(rect()).adjusted(0, 4, 0, -18);
+  if (yMax > 0 && plot.width() > 0 && plot.height() > 0) {
+    const double sx = plot.width() / (hi - lo);
+    const double sy = plot.height() / yMax;
+    const QTransform base(sx, 0, 0, -sy, plot.left() - lo * sx, plot.bottom());
+
+    painter.save();
+    painter.setClipRect(plot);
+    paintSide(painter, BookSide::Bid, bidFirst, bidLast, base, sy);
+    paintSide(painter, BookSide::Ask, askFirst, askLast, base, sy);
+    painter.restore();
+  }
+
+  // Mid line and labels, in widget coordinates
+  const int decimals = SymbolRegistry::instance()->info(m_symbol).priceDecimals();
+  painter.setPen(QPen(QColor("#787b86"), 1, Qt::DashLine));
+  const int midX = static_cast<int>(plot.center().x());
+  painter.drawLine(midX, static_cast<int>(plot.top()), midX, static_cast<int>(plot.bottom()));
+
+  QFont font = painter.font();
+  font.setPixelSize(10);
+  painter.setFont(font);
+  painter.setPen(QColor("#848e9c"));
+  const QRectF labels(plot.left() + 4, plot.bottom() + 2, plot.width() - 8, 14);
+  painter.drawText(labels, Qt::AlignLeft | Qt::AlignVCenter, QString::number(lo, 'f', decimals));
+  painter.drawText(labels, Qt::AlignHCenter | Qt::AlignVCenter, QString::number(mid, 'f', decimals));
+  painter.drawText(labels, Qt::AlignRight | Qt::AlignVCenter, QString::number(hi, 'f', decimals));
+  painter.drawText(plot.adjusted(4, 2, -4, 0), Qt::AlignLeft | Qt::AlignTop, QString::number(yMax / 1.1, 'f', 2));
+
+  // Chunks left behind by the mid are rebuilt if it comes back
+  auto prune = [](ChunkMap &map, int64_t low, int64_t high) {
+    if (map.size() <= 4 * CHUNKS_PER_SIDE) return;
+    for (auto it = map.begin(); it != map.end();) {
+      if (it.key() < low || it.key() > high) it = map.erase(it);
+      else ++it;
+    }
+  };
+  prune(m_bidChunks, bidLast, bidFirst);
+  prune(m_askChunks, askFirst, askLast);
+}
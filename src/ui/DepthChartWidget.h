@@ -0,0 +1,82 @@
+/**
+ * @file DepthChartWidget.h
+ * @brief Cumulative depth curve (bids left, asks right) around the mid.
+ *
+ * The visible price window is split into fixed price chunks. Each chunk
+ * caches its step curve as QPainterPaths in data coordinates (price,
+ * quantity relative to the chunk start), so:
+ * - a level change rebuilds only the chunk it falls in
+ * - chunks farther from the mid keep their paths and are just translated
+ *   by the new cumulative quantity in front of them
+ * - zoom, resize and mid moves only change the painter transform
+ * Repaints are coalesced to display rate; only chunks inside the window
+ * are built and drawn.
+ */
+
+#ifndef DEPTHCHARTWIDGET_H
+#define DEPTHCHARTWIDGET_H
+
+#include <QHash>
+#include <QPainterPath>
+#include <QTimer>
+#include <QWidget>
+#include "L2Book.h"
+#include "MarketEvents.h"
+
+/**
+ * @class DepthChartWidget
+ * @brief Depth chart of the displayed symbol, fed by MarketDataHub.
+ */
+class DepthChartWidget : public QWidget {
+  Q_OBJECT
+
+public:
+  static constexpr int FRAME_INTERVAL_MS = 16;
+  static constexpr int CHUNKS_PER_SIDE = 32;        // Chunks between the mid and a window edge
+  static constexpr double DEFAULT_WINDOW = 0.005;   // Half window, relative to the mid
+  static constexpr double MIN_WINDOW = 0.0005;
+  static constexpr double MAX_WINDOW = 0.1;
+
+  explicit DepthChartWidget(QWidget *parent = nullptr);
+  ~DepthChartWidget();
+
+public slots:
+  void setSymbol(const QString &symbol);
+
+protected:
+  void paintEvent(QPaintEvent *event) override;
+  void wheelEvent(QWheelEvent *event) override;
+
+private slots:
+  void onBookUpdated(const BookUpdate &update);
+  void onFrame();
+
+private:
+  struct Chunk {
+    QPainterPath line;    // Step curve, y relative to the chunk's first level
+    QPainterPath fill;    // Area under it, closed at relative 0
+    double qty = 0;       // Quantity of the chunk's levels
+    bool dirty = true;
+  };
+  using ChunkMap = QHash<int64_t, Chunk>;
+
+  ChunkMap &chunks(BookSide side) { return side == BookSide::Bid ? m_bidChunks : m_askChunks; }
+  int64_t chunkOf(Price price) const { return price.floorTo(m_chunkWidth).raw() / m_chunkWidth.raw(); }
+  void markDirty(BookSide side, const std::vector<BookLevel> &levels);
+  void resetChunks();
+  void rebuild(BookSide side, int64_t index, Chunk &chunk);
+  void paintSide(QPainter &painter, BookSide side, int64_t first, int64_t last, const QTransform &base, double yScale);
+
+  QString m_symbol;
+  L2Book m_book;
+  bool m_bookReady = false;
+  bool m_dirty = false;
+  QTimer *m_frameTimer;
+
+  double m_window = DEFAULT_WINDOW;
+  Price m_chunkWidth;             // Zero until the first paint with a book
+  ChunkMap m_bidChunks;
+  ChunkMap m_askChunks;
+};
+
+#endif // DEPTHCHARTWIDGET_H
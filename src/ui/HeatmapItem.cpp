@@ -0,0 +1,141 @@
+#include "HeatmapItem.h"
+#include <QPainter>
+#include <algorithm>
+#include <cmath>
+
+HeatmapItem::HeatmapItem(const DepthHeatmap *heatmap, QGraphicsItem *parent)
+    : QGraphicsItem(parent), m_heatmap(heatmap), m_palette(256, 0) {
+  setAcceptedMouseButtons(Qt::NoButton);
+}
+
+void HeatmapItem::setView(const QRectF &plot, qint64 t0, qint64 t1, double p0, double p1) {
+  if (plot == m_plot && t0 == m_t0 && t1 == m_t1 && p0 == m_p0 && p1 == m_p1) return;
+  if (plot != m_plot) prepareGeometryChange();
+  m_plot = plot;
+  m_t0 = t0;
+  m_t1 = t1;
+  m_p0 = p0;
+  m_p1 = p1;
+  invalidate();
+}
+
+void HeatmapItem::invalidate() {
+  m_dirty = true;
+  update();
+}
+
+void HeatmapItem::columnAppended() {
+  if (m_heatmap->empty()) return;
+  const DepthHeatmap::Column column = m_heatmap->newest();
+  if (m_t1 <= m_t0 || column.time < m_t0 || column.time > m_t1) return;
+  if (m_dirty || m_image.isNull()) {
+    // The pending rebuild draws it
+    update();
+    return;
+  }
+
+  // Same placement as rebuild(): a sample at m_t1 goes to the last pixel column
+  const int x = std::min(columnOf(column.time), m_image.width() - 1);
+
+  if (std::max<uint8_t>(1, m_heatmap->maxCode()) != m_paletteMax) {
+    // New colour scale: recolour from the stored codes, the ring is not touched
+    updatePalette();
+    const int w = m_image.width();
+    for (int y = 0; y < m_image.height(); ++y) {
+      QRgb *line = reinterpret_cast<QRgb *>(m_image.scanLine(y));
+      const uint8_t *codes = &m_codes[static_cast<size_t>(y) * w];
+      for (int i = 0; i < w; ++i) line[i] = m_palette[codes[i]];
+    }
+    blit(column, x);
+    update();
+    return;
+  }
+
+  blit(column, x);
+  update(QRectF(m_plot.left() + x, m_plot.top(), 1, m_plot.height()));
+}
+
+void HeatmapItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *, QWidget *) {
+  if (m_dirty) {
+    rebuild();
+    m_dirty = false;
+  }
+  if (!m_image.isNull()) painter->drawImage(m_plot.topLeft(), m_image);
+}
+
+int HeatmapItem::columnOf(qint64 time) const {
+  if (m_t1 <= m_t0) return -1;
+  return static_cast<int>((time - m_t0) * m_image.width() / (m_t1 - m_t0));
+}
+
+void HeatmapItem::rebuild() {
+  const int w = static_cast<int>(m_plot.width());
+  const int h = static_cast<int>(m_plot.height());
+  if (w <= 0 || h <= 0) {
+    m_image = QImage();
+    return;
+  }
+
+  m_image = QImage(w, h, QImage::Format_ARGB32_Premultiplied);
+  m_image.fill(Qt::transparent);
+  m_codes.assign(static_cast<size_t>(w) * h, 0);
+  updatePalette();
+  if (m_heatmap->empty() || m_t1 <= m_t0 || m_p1 <= m_p0) return;
+
+  // Only the columns inside the time range
+  for (size_t i = m_heatmap->lowerBound(m_t0); i < m_heatmap->size(); ++i) {
+    const DepthHeatmap::Column column = m_heatmap->column(i);
+    if (column.time > m_t1) break;
+    blit(column, std::min(columnOf(column.time), w - 1));
+  }
+}
+
+void HeatmapItem::blit(const DepthHeatmap::Column &column, int x) {
+  const int h = m_image.height();
+  const double step = m_heatmap->binStep().toDouble();
+  const double pixelPrice = (m_p1 - m_p0) / h;
+
+  for (int k = 0; k < DepthHeatmap::BINS; ++k) {
+    const uint8_t code = column.cells[k];
+    if (code == 0) continue;
+
+    const double low = static_cast<double>(column.firstBin + k) * step;
+    const double high = low + step;
+    if (high <= m_p0 || low >= m_p1) continue;
+
+    // Price grows upwards: a bin covers at least one pixel row
+    const int top = std::max(0, static_cast<int>(std::floor((m_p1 - high) / pixelPrice)));
+    const int bottom = std::min(h, std::max(top + 1, static_cast<int>(std::ceil((m_p1 - low) / pixelPrice))));
+    for (int y = top; y < bottom; ++y) setPixel(x, y, code);
+  }
+}
+
+void HeatmapItem::setPixel(int x, int y, uint8_t code) {
+  uint8_t &stored = m_codes[static_cast<size_t>(y) * m_image.width() + x];
+  if (code <= stored) return;
+  stored = code;
+  reinterpret_cast<QRgb *>(m_image.scanLine(y))[x] = m_palette[code];
+}
+
+void HeatmapItem::updatePalette() {
+  m_paletteMax = std::max<uint8_t>(1, m_heatmap->maxCode());
+
+  // Transparent -> blue -> cyan -> yellow, opacity rising with size
+  m_palette[0] = qPremultiply(qRgba(0, 0, 0, 0));
+  for (int c = 1; c < 256; ++c) {
+    const double t = std::min(1.0, static_cast<double>(c) / m_paletteMax);
+    int r, g, b;
+    if (t < 0.5) {
+      const double u = t / 0.5;
+      r = static_cast<int>(30 * (1 - u));
+      g = static_cast<int>(60 + 140 * u);
+      b = static_cast<int>(200 + 20 * u);
+    } else {
+      const double u = (t - 0.5) / 0.5;
+      r = static_cast<int>(250 * u);
+      g = static_cast<int>(200 + 20 * u);
+      b = static_cast<int>(220 * (1 - u) + 40 * u);
+    }
+    m_palette[c] = qPremultiply(qRgba(r, g, b, static_cast<int>(20 + 180 * t * t)));
+  }
+}
@@ -0,0 +1,61 @@
+/**
+ * @file HeatmapItem.h
+ * @brief Liquidity heatmap drawn behind the chart candles.
+ *
+ * One scene item covering the plot area, painted from a QImage with one
+ * pixel per screen position. Heatmap columns are blitted into it: a view
+ * change (pan, zoom, resize) redraws the image from the DepthHeatmap ring,
+ * a new sample only max-merges its column into the pixel column it falls
+ * on. Per-pixel codes are kept next to the image, so a new colour scale
+ * recolours without going back to the ring.
+ */
+
+#ifndef HEATMAPITEM_H
+#define HEATMAPITEM_H
+
+#include <QGraphicsItem>
+#include <QImage>
+#include <QVector>
+#include <vector>
+#include "DepthHeatmap.h"
+
+/**
+ * @class HeatmapItem
+ * @brief Renders a DepthHeatmap over a time x price view rectangle.
+ */
+class HeatmapItem : public QGraphicsItem {
+public:
+  explicit HeatmapItem(const DepthHeatmap *heatmap, QGraphicsItem *parent = nullptr);
+
+  /// Plot rectangle (parent coordinates) and the time / price ranges it shows.
+  void setView(const QRectF &plot, qint64 t0, qint64 t1, double p0, double p1);
+
+  /// Redraw everything from the ring (after clear, or a bin step change).
+  void invalidate();
+
+  /// Blits the newest column of the ring.
+  void columnAppended();
+
+  QRectF boundingRect() const override { return m_plot; }
+  void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override;
+
+private:
+  void rebuild();
+  void blit(const DepthHeatmap::Column &column, int x);
+  void setPixel(int x, int y, uint8_t code);
+  void updatePalette();
+  int columnOf(qint64 time) const;
+
+  const DepthHeatmap *m_heatmap;
+  QRectF m_plot;
+  qint64 m_t0 = 0, m_t1 = 0;
+  double m_p0 = 0, m_p1 = 0;
+
+  QImage m_image;                 // ARGB32 premultiplied, plot size
+  std::vector<uint8_t> m_codes;   // Max code per pixel, row-major
+  QVector<QRgb> m_palette;        // Code -> colour, scaled to the ring's max code
+  uint8_t m_paletteMax = 0;
+  bool m_dirty = true;
+};
+
+#endif // HEATMAPITEM_H
@@ -5,14 +5,16 @@
  * Sets up the complete UI layout including:
  * - Ticker selector bar (top)
  * - Candlestick chart with RSI indicator (center-left)
- * - Order book display (center-right)
- * - Order entry panel (right sidebar)
+ * - Order book display with depth chart (center-right)
+ * - Order entry panel and trade tape (right sidebar)
  * - Trading bottom panel with orders/positions (bottom)
  */
 
 #include "MainWindow.h"
 #include "ChartWidget.h"
+#include "DepthChartWidget.h"
 #include "TickerPlaceholder.h"
+#include "TimeAndSalesPanel.h"
 #include "TradingBottomPanel.h"
 #include "orderbook.h"
 #include "OrderEntryPanel.h"
@@ -109,11 +111,14 @@ void MainWindow::setupUi() {
   zone3->setStyleSheet("background-color: #161616;");
   QVBoxLayout *z3l = new QVBoxLayout(zone3);
   OrderBook *orderBook = new OrderBook(zone3);
-  z3l->addWidget(orderBook);
+  z3l->addWidget(orderBook, 3);
+  DepthChartWidget *depthChart = new DepthChartWidget(zone3);
+  z3l->addWidget(depthChart, 1);
   pinkLayout->addWidget(zone3, 1); // Zone 3 takes 25% of Pink width
 
   // Connect ticker selection to orderbook update
   connect(tickerWidget, &TickerPlaceholder::tickerChanged, orderBook, &OrderBook::setSymbol);
+  connect(tickerWidget, &TickerPlaceholder::tickerChanged, depthChart, &DepthChartWidget::setSymbol);
 
   yellowLayout->addWidget(pinkContainer, 3); // Pink takes 75% of Yellow height
 
@@ -136,9 +141,12 @@ void MainWindow::setupUi() {
     z4l->setContentsMargins(0, 0, 0, 0);
     OrderEntryPanel* orderEntry = new OrderEntryPanel(zone4);
     z4l->addWidget(orderEntry);
+    TimeAndSalesPanel* tape = new TimeAndSalesPanel(zone4);
+    z4l->addWidget(tape, 1);
 
     // Connect ticker selection and prices
     connect(tickerWidget, &TickerPlaceholder::tickerChanged, orderEntry, &OrderEntryPanel::setSymbol);
+    connect(tickerWidget, &TickerPlaceholder::tickerChanged, tape, &TimeAndSalesPanel::setSymbol);
     connect(tickerWidget, &TickerPlaceholder::priceUpdated, orderEntry, &OrderEntryPanel::setCurrentPrice);
     connect(tickerWidget, &TickerPlaceholder::priceUpdated, bottomPanel, &TradingBottomPanel::updateMarkPrices);
 
@@ -15,6 +15,12 @@ static const QString COLOR_BUY = "#2db9b9";
 static const QString COLOR_SELL = "#e24a6d";
 
 OrderEntryPanel::OrderEntryPanel(QWidget *parent) : QWidget(parent) {
+    SymbolRegistry *registry = SymbolRegistry::instance();
+    m_symbolInfo = registry->info(m_symbol);
+    connect(registry, &SymbolRegistry::symbolsUpdated, this, [this]() {
+        m_symbolInfo = SymbolRegistry::instance()->info(m_symbol);
+    });
+
     setupUI();
     setupStyle();
     updateTheme();
@@ -307,34 +313,40 @@ void OrderEntryPanel::onSellClicked() {
     updateTheme();
 }
 
+Price OrderEntryPanel::toTick(double price) const {
+    return Price::fromDouble(price).roundTo(m_symbolInfo.tickSize);
+}
+
+Qty OrderEntryPanel::toStep(double qty) const {
+    return Qty::fromDouble(qty).floorTo(m_symbolInfo.stepSize);
+}
+
+QString OrderEntryPanel::formatPrice(Price price) const {
+    return QString::number(price.toDouble(), 'f', m_symbolInfo.priceDecimals());
+}
+
+QString OrderEntryPanel::formatQty(Qty qty) const {
+    return QString::number(qty.toDouble(), 'f', m_symbolInfo.qtyDecimals());
+}
+
 void OrderEntryPanel::onPlaceOrderClicked() {
     double size = m_sizeInput->text().toDouble();
     if (size <= 0.0) return;
 
     QString typeStr = (m_currentMode == Market) ? "Market" : "Limit";
-    double price = 0.0;
-    QString priceStr = "Market";
 
-    if (m_currentMode == Limit) {
-        price = m_priceInput->text().toDouble();
-        if (price <= 0.0) return;
-        priceStr = QString::number(price, 'f', 2);
-    } else {
-        price = m_currentMarketPrice;
-        priceStr = QString::number(price, 'f', 2);
-    }
+    // Orders carry exchange-valid values: price on the tick grid, size on the step grid
+    Price price = toTick(m_currentMode == Limit ? m_priceInput->text().toDouble() : m_currentMarketPrice);
+    if (!price.isPositive()) return;
 
-    double costUsdc = 0.0;
-    QString amountStr;
+    Qty quantity = toStep(m_unitCombo->currentText() == "USDC" ? size / price.toDouble() : size);
+    if (!quantity.isPositive() || quantity < m_symbolInfo.minQty) return;
 
-    if (m_unitCombo->currentText() == "USDC") {
-        costUsdc = size;
-        double tokenAmount = size / price;
-        amountStr = QString("%1 %2").arg(QString::number(tokenAmount, 'f', 5), m_symbol);
-    } else {
-        costUsdc = size * price;
-        amountStr = QString("%1 %2").arg(QString::number(size, 'f', 5), m_symbol);
-    }
+    double costUsdc = quantity.toDouble() * price.toDouble();
+    if (costUsdc < m_symbolInfo.minNotional) return;
+
+    QString priceStr = formatPrice(price);
+    QString amountStr = QString("%1 %2").arg(formatQty(quantity), m_symbol);
 
     QString availText = m_availableValue->text();
     double avail = availText.split(" ").first().toDouble();
@@ -369,7 +381,7 @@ void OrderEntryPanel::onSliderValueChanged(int value) {
         }
         if (price <= 0.0) price = m_currentMarketPrice;
         sizeVal = sizeVal / price;
-        m_sizeInput->setText(QString::number(sizeVal, 'f', 5));
+        m_sizeInput->setText(formatQty(toStep(sizeVal)));
     } else {
         m_sizeInput->setText(QString::number(sizeVal, 'f', 2));
     }
@@ -404,7 +416,7 @@ void OrderEntryPanel::onTpGainEdited(const QString &text) {
     }
     
     if (targetPrice > 0.0) {
-        m_tpPriceInput->setText(QString::number(targetPrice, 'f', 2));
+        m_tpPriceInput->setText(formatPrice(toTick(targetPrice)));
     }
 }
 
@@ -433,7 +445,7 @@ void OrderEntryPanel::onSlLossEdited(const QString &text) {
     }
     
     if (targetPrice > 0.0) {
-        m_slPriceInput->setText(QString::number(targetPrice, 'f', 2));
+        m_slPriceInput->setText(formatPrice(toTick(targetPrice)));
     }
 }
 
@@ -489,6 +501,7 @@ void OrderEntryPanel::updateTheme() {
 void OrderEntryPanel::setSymbol(const QString &symbol) {
     if (m_symbol == symbol) return;
     m_symbol = symbol;
+    m_symbolInfo = SymbolRegistry::instance()->info(symbol);
     m_unitCombo->setItemText(0, m_symbol);
 }
 
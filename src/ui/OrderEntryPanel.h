@@ -9,6 +9,7 @@
 #include <QCheckBox>
 #include <QComboBox>
 #include <QButtonGroup>
+#include "SymbolRegistry.h"
 
 class OrderEntryPanel : public QWidget {
     Q_OBJECT
@@ -44,6 +45,7 @@ private:
     OrderMode m_currentMode = Market;
     OrderSide m_currentSide = Buy;
     QString m_symbol = "BTC";
+    SymbolInfo m_symbolInfo;
     double m_currentMarketPrice = 96000.0;
 
     // Header buttons
@@ -83,6 +85,12 @@ private:
     void setupStyle();
     QWidget* createInfoRow(const QString &label, QLabel **valueLabel);
     QWidget* createInputRow(const QString &label, QLineEdit **input, const QString &suffix = "");
+
+    // Exchange rounding: prices to the tick size, sizes down to the step size
+    Price toTick(double price) const;
+    Qty toStep(double qty) const;
+    QString formatPrice(Price price) const;
+    QString formatQty(Qty qty) const;
 };
 
 #endif // ORDERENTRYPANEL_H
@@ -1,4 +1,5 @@
 #include "TickerPlaceholder.h"
+#include "MarketDataHub.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QHeaderView>
@@ -125,15 +126,21 @@ TickerPlaceholder::TickerPlaceholder(QWidget *parent) : QWidget(parent), m_curre
     setAttribute(Qt::WA_StyledBackground, true);
     setupUI();
 
-    m_networkManager = new QNetworkAccessManager(this);
-    connect(m_networkManager, &QNetworkAccessManager::finished, this, &TickerPlaceholder::onHttpResponse);
+    // Les stats 24h arrivent en continu via le hub (flux @ticker)
+    MarketDataHub* hub = MarketDataHub::instance();
+    connect(hub, &MarketDataHub::tickerUpdated, this, &TickerPlaceholder::onTickerUpdated);
+    hub->subscribe(MarketDataHub::Stream::Ticker24h, m_currentSymbol);
 
-    m_pollTimer = new QTimer(this);
-    m_pollTimer->setInterval(1000); // Rafraîchir toutes les secondes
-    connect(m_pollTimer, &QTimer::timeout, this, &TickerPlaceholder::fetchTickerData);
-    m_pollTimer->start();
+    m_countdownTimer = new QTimer(this);
+    m_countdownTimer->setInterval(1000); // Rafraîchir toutes les secondes
+    connect(m_countdownTimer, &QTimer::timeout, this, &TickerPlaceholder::updateCountdown);
+    m_countdownTimer->start();
 
-    fetchTickerData();
+    updateCountdown();
+}
+
+TickerPlaceholder::~TickerPlaceholder() {
+    MarketDataHub::instance()->unsubscribe(MarketDataHub::Stream::Ticker24h, m_currentSymbol);
 }
 
 void TickerPlaceholder::setupUI() {
@@ -299,22 +306,20 @@ void TickerPlaceholder::updateTickerDisplay(const TickerData &data) {
 
     // 2. Extraire le symbole de base (ex: "BTC/USD" -> "BTC")
     QString cleanSymbol = data.symbol.split("/").first();
-    m_currentSymbol = cleanSymbol;
 
-    // 3. Forcer une mise à jour immédiate
-    fetchTickerData();
+    // 3. Basculer l'abonnement (le hub publie immédiatement un ticker REST)
+    if (cleanSymbol != m_currentSymbol) {
+        MarketDataHub* hub = MarketDataHub::instance();
+        hub->subscribe(MarketDataHub::Stream::Ticker24h, cleanSymbol);
+        hub->unsubscribe(MarketDataHub::Stream::Ticker24h, m_currentSymbol);
+        m_currentSymbol = cleanSymbol;
+    }
 
     // 4. Emettre le signal pour le chart et l'orderbook
     emit tickerChanged(cleanSymbol);
 }
 
-void TickerPlaceholder::fetchTickerData() {
-    // On requête l'API Binance pour le ticker 24h
-    QString url = QString("https://api.binance.com/api/v3/ticker/24hr?symbol=%1USDT").arg(m_currentSymbol);
-    QNetworkRequest request{QUrl(url)};
-    m_networkManager->get(request);
-
-    // Update countdown
+void TickerPlaceholder::updateCountdown() {
     qint64 now = QDateTime::currentDateTimeUtc().toMSecsSinceEpoch();
     qint64 duration = 0;
     QString intv = currentInterval();
@@ -338,25 +343,15 @@ void TickerPlaceholder::fetchTickerData() {
     }
 }
 
-void TickerPlaceholder::onHttpResponse(QNetworkReply* reply) {
-    reply->deleteLater();
+void TickerPlaceholder::onTickerUpdated(const Ticker24h& ticker) {
+    if (ticker.symbol != m_currentSymbol) return;
 
-    if (reply->error() != QNetworkReply::NoError) {
-        return;
-    }
-
-    QByteArray data = reply->readAll();
-    QJsonDocument doc = QJsonDocument::fromJson(data);
-    if (doc.isNull() || !doc.isObject()) return;
-
-    QJsonObject obj = doc.object();
-
-    double lastPrice = obj["lastPrice"].toString().toDouble();
+    double lastPrice = ticker.lastPrice;
     emit priceUpdated(lastPrice);
-    
-    double changeVal = obj["priceChange"].toString().toDouble();
-    double changePercent = obj["priceChangePercent"].toString().toDouble();
-    double quoteVolume = obj["quoteVolume"].toString().toDouble(); // Volume en USDT
+
+    double changeVal = ticker.priceChange;
+    double changePercent = ticker.priceChangePercent;
+    double quoteVolume = ticker.quoteVolume; // Volume en USDT
 
     // Formattage du prix
     QString priceStr;
@@ -8,14 +8,10 @@
 #include <QLabel>
 #include <QPushButton>
 #include <QElapsedTimer>
-#include <QNetworkAccessManager>
-#include <QNetworkReply>
-#include <QJsonDocument>
-#include <QJsonObject>
-#include <QJsonArray>
 #include <QTimer>
 #include <QComboBox>
 #include <QDateTime>
+#include "MarketEvents.h"
 
 // Structure pour transporter les données d'une crypto
 struct TickerData {
@@ -55,6 +51,7 @@ class TickerPlaceholder : public QWidget {
     Q_OBJECT
 public:
     explicit TickerPlaceholder(QWidget *parent = nullptr);
+    ~TickerPlaceholder();
 
 signals:
     // Signal emitted when user selects a different coin
@@ -70,8 +67,8 @@ private slots:
     void openTickerSelector();
     // Slot pour recevoir les données et mettre à jour l'UI
     void updateTickerDisplay(const TickerData &data);
-    void fetchTickerData();
-    void onHttpResponse(QNetworkReply* reply);
+    void updateCountdown();
+    void onTickerUpdated(const Ticker24h& ticker);
 
 private:
     // UI Elements interactifs (stockés pour pouvoir les modifier)
@@ -85,8 +82,7 @@ private:
     QLabel *volumeLabel;
     QLabel *capLabel;
 
-    QNetworkAccessManager *m_networkManager;
-    QTimer *m_pollTimer;
+    QTimer *m_countdownTimer;
     QString m_currentSymbol;
 
     void setupUI();
@@ -0,0 +1,114 @@
+#include "TimeAndSalesPanel.h"
+#include "DepthLadderModel.h"
+#include "MarketDataHub.h"
+#include <QDateTime>
+#include <QPainter>
+#include <algorithm>
+
+TimeAndSalesPanel::TimeAndSalesPanel(QWidget *parent)
+    : QWidget(parent), m_symbol("BTC"), m_rows(MAX_ROWS) {
+  setMinimumHeight(120);
+  setAttribute(Qt::WA_OpaquePaintEvent);
+  m_info = SymbolRegistry::instance()->info(m_symbol);
+
+  connect(SymbolRegistry::instance(), &SymbolRegistry::symbolsUpdated, this, [this]() {
+    m_info = SymbolRegistry::instance()->info(m_symbol);
+    update();
+  });
+
+  MarketDataHub *hub = MarketDataHub::instance();
+  connect(hub, &MarketDataHub::tradesReceived, this, &TimeAndSalesPanel::onTrades);
+  hub->subscribe(MarketDataHub::Stream::Trade, m_symbol);
+}
+
+TimeAndSalesPanel::~TimeAndSalesPanel() {
+  MarketDataHub::instance()->unsubscribe(MarketDataHub::Stream::Trade, m_symbol);
+}
+
+void TimeAndSalesPanel::setSymbol(const QString &symbol) {
+  if (symbol == m_symbol) return;
+
+  MarketDataHub *hub = MarketDataHub::instance();
+  hub->subscribe(MarketDataHub::Stream::Trade, symbol);
+  hub->unsubscribe(MarketDataHub::Stream::Trade, m_symbol);
+  m_symbol = symbol;
+  m_info = SymbolRegistry::instance()->info(symbol);
+  m_next = 0;
+  m_count = 0;
+  update();
+}
+
+void TimeAndSalesPanel::onTrades(const TradeBatch &batch) {
+  bool changed = false;
+  for (const Trade &trade : batch.trades) {
+    if (trade.symbol != m_symbol) continue;
+    append(trade);
+    changed = true;
+  }
+  // A batch is drained once per frame, so this is at most one repaint per frame
+  if (changed) update();
+}
+
+void TimeAndSalesPanel::append(const Trade &trade) {
+  if (m_count > 0) {
+    Row &last = m_rows[(m_next + MAX_ROWS - 1) % MAX_ROWS];
+    if (last.timeMs == trade.timeMs && last.price == trade.price && last.sell == trade.buyerIsMaker) {
+      last.qty += trade.qty;
+      last.prints++;
+      return;
+    }
+  }
+
+  Row &row = m_rows[m_next];
+  row.price = trade.price;
+  row.qty = trade.qty;
+  row.timeMs = trade.timeMs;
+  row.sell = trade.buyerIsMaker;
+  row.prints = 1;
+  m_next = (m_next + 1) % MAX_ROWS;
+  if (m_count < MAX_ROWS) m_count++;
+}
+
+void TimeAndSalesPanel::paintEvent(QPaintEvent *) {
+  QPainter painter(this);
+  painter.fillRect(rect(), QColor("#161616"));
+
+  QFont font("Consolas");
+  font.setStyleHint(QFont::Monospace);
+  font.setPixelSize(11);
+  painter.setFont(font);
+
+  // Columns: price | amount | time
+  const int w = width();
+  const QRect priceCol(8, 0, w / 3, ROW_HEIGHT);
+  const QRect qtyCol(w / 3, 0, w / 3, ROW_HEIGHT);
+  const QRect timeCol(2 * w / 3, 0, w / 3 - 8, ROW_HEIGHT);
+
+  painter.setPen(QColor("#848e9c"));
+  const int headerY = (HEADER_HEIGHT - ROW_HEIGHT) / 2;
+  painter.drawText(priceCol.translated(0, headerY), Qt::AlignLeft | Qt::AlignVCenter, "Price");
+  painter.drawText(qtyCol.translated(0, headerY), Qt::AlignRight | Qt::AlignVCenter, "Amount");
+  painter.drawText(timeCol.translated(0, headerY), Qt::AlignRight | Qt::AlignVCenter, "Time");
+
+  // Only the rows that fit are formatted
+  const int decimals = m_info.priceDecimals();
+  const QColor buy("#0ecb81");
+  const QColor sell("#f6465d");
+  const QColor text("#c3c5cb");
+  const int visible = std::min(m_count, (height() - HEADER_HEIGHT) / ROW_HEIGHT + 1);
+  for (int i = 0; i < visible; ++i) {
+    const Row &row = newest(i);
+    const int y = HEADER_HEIGHT + i * ROW_HEIGHT;
+
+    painter.setPen(row.sell ? sell : buy);
+    painter.drawText(priceCol.translated(0, y), Qt::AlignLeft | Qt::AlignVCenter,
+                     DepthLadderModel::formatNumber(row.price, decimals));
+    painter.setPen(text);
+    const QString qty = DepthLadderModel::formatQty(row.qty);
+    painter.drawText(qtyCol.translated(0, y), Qt::AlignRight | Qt::AlignVCenter,
+                     row.prints > 1 ? QString("%1 ×%2").arg(qty).arg(row.prints) : qty);
+    painter.setPen(QColor("#848e9c"));
+    painter.drawText(timeCol.translated(0, y), Qt::AlignRight | Qt::AlignVCenter,
+                     QDateTime::fromMSecsSinceEpoch(row.timeMs).toString("HH:mm:ss"));
+  }
+}
@@ -0,0 +1,64 @@
+/**
+ * @file TimeAndSalesPanel.h
+ * @brief Trade tape (time & sales) of the displayed symbol.
+ *
+ * Prints arrive from MarketDataHub as one TradeBatch per frame. Consecutive
+ * prints of the same side, price and millisecond (one taker sweeping
+ * several makers) are merged into a single row, and rows are kept in a
+ * fixed-size ring, so a burst only costs a few comparisons per print.
+ * Painting formats just the rows that fit in the widget; a frame stays
+ * well under the display budget whatever the print rate.
+ */
+
+#ifndef TIMEANDSALESPANEL_H
+#define TIMEANDSALESPANEL_H
+
+#include <QWidget>
+#include <vector>
+#include "MarketEvents.h"
+#include "SymbolRegistry.h"
+
+/**
+ * @class TimeAndSalesPanel
+ * @brief Newest-first list of the latest prints, colored by aggressor side.
+ */
+class TimeAndSalesPanel : public QWidget {
+  Q_OBJECT
+
+public:
+  static constexpr int MAX_ROWS = 512;          // Rows kept (ring)
+  static constexpr int ROW_HEIGHT = 16;
+  static constexpr int HEADER_HEIGHT = 22;
+
+  explicit TimeAndSalesPanel(QWidget *parent = nullptr);
+  ~TimeAndSalesPanel();
+
+public slots:
+  void setSymbol(const QString &symbol);
+
+protected:
+  void paintEvent(QPaintEvent *event) override;
+
+private slots:
+  void onTrades(const TradeBatch &batch);
+
+private:
+  struct Row {
+    double price = 0;
+    double qty = 0;
+    qint64 timeMs = 0;
+    bool sell = false;      // Taker sold (buyer was the maker)
+    int prints = 1;         // Merged prints
+  };
+
+  void append(const Trade &trade);
+  const Row &newest(int i) const { return m_rows[(m_next + MAX_ROWS - 1 - i) % MAX_ROWS]; }
+
+  QString m_symbol;
+  SymbolInfo m_info;
+  std::vector<Row> m_rows;
+  int m_next = 0;           // Slot of the next row
+  int m_count = 0;
+};
+
+#endif // TIMEANDSALESPANEL_H